@@ -0,0 +1,25 @@
+#version 410 core
+layout (location = 0) in int aOrbit; // Instanced: slot of the orbit in uEllipses
+
+// Two texels per orbit, render frame (Earth radii):
+//   A = a * P, w = e
+//   B = b * Q
+uniform samplerBuffer uEllipses;
+uniform int uSegments; // Vertices are 0..uSegments, the last closes the loop
+
+uniform mat4 view;
+uniform mat4 projection;
+
+const float TWO_PI = 6.28318530717958647692;
+
+void main()
+{
+    vec4 axisA = texelFetch(uEllipses, 2 * aOrbit);
+    vec3 axisB = texelFetch(uEllipses, 2 * aOrbit + 1).xyz;
+    
+    // Uniform steps in eccentric anomaly: no Kepler solve, and denser near
+    // periapsis where an eccentric ellipse curves most
+    float E = TWO_PI * float(gl_VertexID % uSegments) / float(uSegments);
+    vec3 position = axisA.xyz * (cos(E) - axisA.w) + axisB * sin(E);
+    gl_Position = projection * view * vec4(position, 1.0);
+}
@@ -1,25 +1,69 @@
 #version 410 core
 layout (location = 0) in vec3 aPos;
-layout (location = 2) in vec3 aInstancePos;
+layout (location = 2) in vec3 aInstancePos;   // CPU path: propagated position (Earth radii)
 layout (location = 3) in vec3 aInstanceColor;
-layout (location = 4) in float aBeaconState;
+layout (location = 4) in int aInstanceId;
+
+// GPU path: static orbit of the instance (ElementsSoA) and its phase
+layout (location = 5) in vec4 aOrbit;         // a (km), e, sqrt(1 - e^2), mean motion (rad/s)
+layout (location = 6) in vec3 aAxisP;         // Perifocal axes, render frame
+layout (location = 7) in vec3 aAxisQ;
+layout (location = 8) in vec2 aPhase;         // Mean anomaly at the elements epoch (rad), visible flag
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform bool uGpuKepler;   // Solve the instance position here instead of reading aInstancePos
+uniform float uTime;       // Sim time - elements epoch (s), kept small by the CPU rebase
+uniform float uSimTime;    // Sim time (s), drives the beacon
 
 out vec3 Color;
 out vec3 FragPos;
 out vec3 LocalPos;
 out float BeaconState;
 
+const float TWO_PI = 6.28318530717958647692;
+const int NEWTON_ITERATIONS = 5; // Same solve as the CPU batch kernel
+
+vec3 keplerPosition()
+{
+    float a = aOrbit.x;
+    float e = aOrbit.y;
+    
+    // Mean anomaly wrapped to [-pi, pi], Danby's starter, then Newton-Raphson
+    float M = aPhase.x + aOrbit.w * uTime;
+    M -= TWO_PI * floor(M / TWO_PI + 0.5);
+    float E = M + (sin(M) > 0.0 ? 0.85 : -0.85) * e;
+    for (int k = 0; k < NEWTON_ITERATIONS; ++k) {
+        E -= (E - e * sin(E) - M) / (1.0 - e * cos(E));
+    }
+    
+    vec3 position = a * (cos(E) - e) * aAxisP + a * aOrbit.z * sin(E) * aAxisQ;
+    return position * (1.0 / 6371.0); // km -> Earth radii
+}
+
 void main()
 {
-    vec3 WorldPos = aPos + aInstancePos;
+    // Destroyed satellites (and those drawn by the CPU path) stay in the static
+    // buffer: move every vertex outside the clip volume
+    if (uGpuKepler && aPhase.y < 0.5) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        Color = vec3(0.0);
+        FragPos = vec3(0.0);
+        LocalPos = aPos;
+        BeaconState = 0.0;
+        return;
+    }
+    
+    vec3 instancePos = uGpuKepler ? keplerPosition() : aInstancePos;
+    vec3 WorldPos = aPos + instancePos;
     gl_Position = projection * view * vec4(WorldPos, 1.0);
     
     LocalPos = aPos;
     FragPos = WorldPos;
-    BeaconState = aBeaconState;
+    
+    // Beacon flash: each satellite blinks at its own rate, picked from the id
+    float blinkSpeed = 2.0 + float(aInstanceId % 10) * 0.3;
+    BeaconState = sin(uSimTime * blinkSpeed) > 0.0 ? 1.0 : 0.0;
     
     // Material-based coloring (ISS-style)
     float distXY = length(aPos.xy);
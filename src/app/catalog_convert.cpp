@@ -0,0 +1,43 @@
+// Converts a JSON or TLE/3LE catalog into the memory-mapped binary format
+// (.satcat) that the app and the headless tool load in milliseconds.
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../util/BinaryCatalog.h"
+#include "../util/ConfigLoader.h"
+#include "../util/Log.h"
+
+int main(int argc, char** argv) {
+    if(argc != 3) {
+        std::cout << "Usage: " << argv[0] << " <input.json|.jsonl|.tle|.3le|.txt> <output.satcat>" << std::endl;
+        return 1;
+    }
+    std::string inputPath = argv[1];
+    std::string outputPath = argv[2];
+    
+    auto start = std::chrono::steady_clock::now();
+    double scenarioEpochJd = 0.0;
+    std::vector<Satellite> satellites = ConfigLoader::LoadSatellites(inputPath, &scenarioEpochJd);
+    if(satellites.empty()) {
+        Log::Flush(); // Loader errors first
+        std::cerr << "No satellites loaded from " << inputPath << std::endl;
+        return 1;
+    }
+    double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    if(!BinaryCatalog::Write(outputPath, satellites, scenarioEpochJd)) return 1;
+    
+    // Read it back to validate the file and show the load time it buys
+    start = std::chrono::steady_clock::now();
+    BinaryCatalog catalog;
+    if(!catalog.open(outputPath)) return 1;
+    std::vector<Satellite> loaded = catalog.toSatellites();
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    Log::Flush();
+    std::cout << "Wrote " << loaded.size() << " objects to " << outputPath << std::endl;
+    std::cout << "Source parse: " << parseSeconds * 1000.0 << " ms | Binary load: "
+              << loadSeconds * 1000.0 << " ms" << std::endl;
+    return 0;
+}
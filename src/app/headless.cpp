@@ -0,0 +1,319 @@
+// Headless batch screening: loads a catalog, steps simulation time as fast as
+// the CPU allows and writes conjunction results to CSV, JSON lines or CDM-style
+// files. No window/GL context.
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include "../sim/SatelliteCatalog.h"
+#include "../sim/OrbitPropagator.h"
+#include "../sim/CollisionDetect.h"
+#include "../sim/conjunctions/ConjunctionAnalyzer.h"
+#include "../sim/conjunctions/ConjunctionExporter.h"
+#include "../util/Checkpoint.h"
+#include "../util/ConfigLoader.h"
+#include "../util/RunRecording.h"
+#include "../util/ScenarioBuilder.h"
+#include "../util/Log.h"
+#include "../util/StageTimer.h"
+
+namespace {
+
+struct HeadlessOptions {
+    std::string catalogPath = "assets/config/satellites.json";
+    std::string outputPath = "conjunctions.csv";
+    ConjunctionExporter::Format format = ConjunctionExporter::Format::CSV;
+    float rotateMb = 0.0f;        // Start a new output file past this size (0 = single file)
+    int randomCount = 0;          // Extra random satellites (same generator as the app)
+    unsigned int seed = 42;
+    bool collisionTest = false;   // Add the 9001/9002 forced collision pair
+    float duration = 3600.0f;     // Simulated seconds to run
+    float step = 1.0f;            // Simulation step (s)
+    float window = 3600.0f;       // Conjunction look-ahead (s)
+    float interval = 60.0f;       // Sim seconds between conjunction analyses
+    int threads = 0;              // Analysis threads (0 = hardware concurrency)
+    bool fullRescan = false;      // Rescan the whole window every analysis instead of sliding it
+    std::string checkpointPath;   // Save state here at the end of the run (and periodically)
+    float checkpointEvery = 0.0f; // Sim seconds between periodic checkpoints (0 = end only)
+    std::string resumePath;       // Continue from this checkpoint instead of loading a catalog
+    std::string recordPath;       // Record the run for replay
+    std::string replayPath;       // Drive the loop from a recording (app or headless) and time each stage
+    LogLevel logLevel = Log::GetLevel();
+};
+
+void PrintUsage(const char* exe) {
+    std::cout << "Usage: " << exe << " [options]\n"
+              << "  --catalog <path>    Satellite catalog: JSON (.json/.jsonl), TLE/3LE (.tle/.3le/.txt) or .satcat (default assets/config/satellites.json)\n"
+              << "  --out <path>        Conjunction output (default conjunctions.csv)\n"
+              << "  --format <fmt>      Output format: csv, jsonl or cdm (default csv)\n"
+              << "  --rotate-mb <n>     Rotate output files at n MB: <stem>.0000<ext>, ... (default: one file)\n"
+              << "  --random <n>        Add n random satellites\n"
+              << "  --seed <n>          Seed for --random (default 42)\n"
+              << "  --collision-test    Add the forced collision test pair\n"
+              << "  --duration <s>      Simulated time to run (default 3600)\n"
+              << "  --step <s>          Simulation time step (default 1)\n"
+              << "  --window <s>        Conjunction look-ahead window (default 3600)\n"
+              << "  --interval <s>      Sim time between analyses (default 60)\n"
+              << "  --threads <n>       Conjunction analysis threads (default: all cores)\n"
+              << "  --full-rescan       Rescan the whole window each analysis (default: incremental)\n"
+              << "  --checkpoint <path> Save the run state to a .satckpt file at the end\n"
+              << "  --checkpoint-every <s>  Also checkpoint every s simulated seconds (written in the background)\n"
+              << "  --resume <path>     Continue a checkpointed run up to --duration (replaces --catalog/--random)\n"
+              << "  --record <path>     Record frame deltas, controls and seeds to a .satrec file\n"
+              << "  --replay <path>     Replay a recording as fast as possible and report per-stage timings\n"
+              << "  --log-level <lvl>   trace, debug, info, warn, error or off (default info, or SATSIM_LOG_LEVEL)\n";
+}
+
+bool ParseArgs(int argc, char** argv, HeadlessOptions& opts) {
+    for(int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if(!strcmp(arg, "--help") || !strcmp(arg, "-h")) return false;
+        else if(!strcmp(arg, "--collision-test")) opts.collisionTest = true;
+        else if(!strcmp(arg, "--full-rescan")) opts.fullRescan = true;
+        else if(!strcmp(arg, "--catalog") && hasValue) opts.catalogPath = argv[++i];
+        else if(!strcmp(arg, "--out") && hasValue) opts.outputPath = argv[++i];
+        else if(!strcmp(arg, "--checkpoint") && hasValue) opts.checkpointPath = argv[++i];
+        else if(!strcmp(arg, "--checkpoint-every") && hasValue) opts.checkpointEvery = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--resume") && hasValue) opts.resumePath = argv[++i];
+        else if(!strcmp(arg, "--record") && hasValue) opts.recordPath = argv[++i];
+        else if(!strcmp(arg, "--replay") && hasValue) opts.replayPath = argv[++i];
+        else if(!strcmp(arg, "--format") && hasValue) {
+            if(!ConjunctionExporter::ParseFormat(argv[++i], opts.format)) {
+                std::cerr << "Unknown output format: " << argv[i] << std::endl;
+                return false;
+            }
+        }
+        else if(!strcmp(arg, "--log-level") && hasValue) {
+            if(!Log::ParseLevel(argv[++i], opts.logLevel)) {
+                std::cerr << "Unknown log level: " << argv[i] << std::endl;
+                return false;
+            }
+        }
+        else if(!strcmp(arg, "--rotate-mb") && hasValue) opts.rotateMb = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--random") && hasValue) opts.randomCount = atoi(argv[++i]);
+        else if(!strcmp(arg, "--seed") && hasValue) opts.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if(!strcmp(arg, "--duration") && hasValue) opts.duration = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--step") && hasValue) opts.step = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--window") && hasValue) opts.window = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--interval") && hasValue) opts.interval = (float)atof(argv[++i]);
+        else if(!strcmp(arg, "--threads") && hasValue) opts.threads = atoi(argv[++i]);
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    if(!opts.resumePath.empty() && (!opts.recordPath.empty() || !opts.replayPath.empty())) {
+        std::cerr << "--record and --replay start from a scenario, not a checkpoint" << std::endl;
+        return false;
+    }
+    return opts.step > 0.0f && opts.duration >= 0.0f;
+}
+
+}
+
+int main(int argc, char** argv) {
+    HeadlessOptions opts;
+    if(!ParseArgs(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    Log::SetLevel(opts.logLevel);
+    
+    SatelliteCatalog catalog;
+    ConjunctionManager colMan;
+    ConjunctionAnalyzer analyzer;
+    if(opts.threads > 0) analyzer.setThreadCount(opts.threads);
+    
+    std::set<std::pair<int,int>> activeCollisions;
+    float conjunctionUpdateTimer = opts.interval; // Analyze on the first step
+    long firstStep = 0;
+    SimTime startTime = 0.0;
+    
+    // A recording defines the scenario and the analysis cadence
+    RunReplay replay;
+    if(!opts.replayPath.empty()) {
+        if(!replay.open(opts.replayPath)) return 1;
+        const RunScenario& scenario = replay.getScenario();
+        opts.catalogPath = scenario.catalogPath;
+        opts.collisionTest = scenario.collisionTest;
+        opts.randomCount = scenario.randomCount;
+        opts.seed = scenario.scenarioSeed;
+        opts.interval = scenario.analysisInterval;
+        opts.window = scenario.analysisWindow;
+        conjunctionUpdateTimer = scenario.initialConjunctionTimer;
+    }
+    
+    double scenarioEpochJd = 0.0; // UTC of sim time 0, 0 if the catalog has none
+    if(!opts.resumePath.empty()) {
+        // The checkpoint holds the whole scenario, including destroyed satellites
+        Checkpoint checkpoint;
+        if(!checkpoint.open(opts.resumePath)) {
+            Log::Flush();
+            return 1;
+        }
+        catalog.addCatalog(checkpoint.catalogView());
+        analyzer.restoreState(checkpoint.events(), checkpoint.eventCount(), checkpoint.getScreeningState());
+        for(const auto& pair : checkpoint.getActiveCollisions()) activeCollisions.insert(pair);
+        conjunctionUpdateTimer = checkpoint.getConjunctionTimer();
+        scenarioEpochJd = checkpoint.getScenarioEpochJd();
+        startTime = checkpoint.getSimTime();
+        firstStep = (long)std::llround(startTime / opts.step) + 1; // Saved after its step completed
+        LOG_INFO("Resuming from " << opts.resumePath << " at t=" << checkpoint.getSimTime() << " s");
+    } else {
+        if(!opts.catalogPath.empty()) {
+            ConfigLoader::LoadInto(catalog, opts.catalogPath, &scenarioEpochJd);
+        }
+        if(opts.collisionTest) ScenarioBuilder::AddCollisionTestPair(catalog);
+        if(opts.randomCount > 0) ScenarioBuilder::AddRandomSatellites(catalog, opts.randomCount, opts.seed);
+    }
+    
+    if(catalog.getSatellites().empty()) {
+        Log::Flush(); // Loader errors first
+        std::cerr << "No satellites loaded, nothing to screen." << std::endl;
+        return 1;
+    }
+    
+    // Results are written on the exporter's thread; a batch run keeps every row,
+    // so a full queue stalls the loop instead of dropping events
+    ConjunctionExporter exporter;
+    exporter.setOverflow(ConjunctionExporter::Overflow::WAIT);
+    exporter.setMaxFileBytes((size_t)(opts.rotateMb * 1024.0f * 1024.0f));
+    exporter.setScenarioEpochJd(scenarioEpochJd);
+    if(!exporter.start(opts.outputPath, opts.format)) {
+        Log::Flush();
+        std::cerr << "Failed to open output: " << opts.outputPath << std::endl;
+        return 1;
+    }
+    
+    RunRecorder recorder;
+    if(!opts.recordPath.empty()) {
+        RunScenario scenario;
+        scenario.catalogPath = opts.catalogPath;
+        scenario.collisionTest = opts.collisionTest;
+        scenario.randomCount = opts.randomCount;
+        scenario.scenarioSeed = opts.seed;
+        scenario.debrisSeed = opts.seed + 1;
+        scenario.analysisInterval = opts.interval;
+        scenario.analysisWindow = opts.window;
+        scenario.initialConjunctionTimer = conjunctionUpdateTimer;
+        if(!recorder.start(opts.recordPath, scenario)) return 1;
+    }
+    
+    if(replay.isOpen()) {
+        LOG_INFO("Headless replay: " << catalog.getSatellites().size() << " satellites, "
+                 << replay.getRecordedFrames() << " recorded frames, propagator: " << OrbitPropagator::BatchIsaName());
+    } else {
+        LOG_INFO("Headless run: " << catalog.getSatellites().size() << " satellites, "
+                 << opts.duration << " s simulated, propagator: " << OrbitPropagator::BatchIsaName());
+    }
+    
+    auto wallStart = std::chrono::steady_clock::now();
+    
+    size_t collisionCount = 0;
+    size_t analysisCount = 0;
+    size_t eventCount = 0;
+    
+    CheckpointWriter checkpointWriter;
+    auto captureState = [&](SimTime simTime) {
+        CheckpointState state;
+        state.simTime = simTime;
+        state.scenarioEpochJd = scenarioEpochJd;
+        state.conjunctionTimer = conjunctionUpdateTimer;
+        state.satellites = catalog.toSatellites();
+        state.activeCollisions.assign(activeCollisions.begin(), activeCollisions.end());
+        state.events = analyzer.getEvents();
+        state.screening = analyzer.getScreeningState();
+        return state;
+    };
+    SimTime nextCheckpoint = startTime + opts.checkpointEvery;
+    SimTime lastSimTime = startTime;
+    
+    enum { STAGE_PROPAGATE, STAGE_COLLISIONS, STAGE_ANALYSIS, STAGE_EXPORT };
+    StageTimer timer({"propagate", "collisions", "analysis", "export"});
+    StageTimer* stageTimer = replay.isOpen() ? &timer : nullptr;
+    
+    RunControls controls; // Fixed-step runs: 1x, never paused
+    SimTime simTime = startTime;
+    long stepCount = (long)(opts.duration / opts.step);
+    for(long k = firstStep; ; ++k) {
+        float frameDelta = opts.step;
+        if(replay.isOpen()) {
+            controls.simTime = simTime;
+            if(!replay.nextFrame(frameDelta, controls)) break;
+            simTime = controls.simTime;
+            if(controls.paused) {
+                timer.endFrame();
+                continue;
+            }
+        } else {
+            if(k > stepCount) break;
+            simTime = k * (SimTime)opts.step;
+            controls.simTime = simTime;
+            recorder.frame(frameDelta, controls);
+        }
+        
+        if(stageTimer) stageTimer->startFrame();
+        catalog.propagate(simTime);
+        if(stageTimer) stageTimer->lap(STAGE_PROPAGATE);
+        colMan.update(catalog.getSatellites(), simTime);
+        
+        // Same collision handling as the windowed app: both objects are destroyed
+        std::set<std::pair<int,int>> currentCollisions;
+        for(const auto& ev : colMan.getEvents()) {
+            std::pair<int,int> key = {ev.sat1_id, ev.sat2_id};
+            currentCollisions.insert(key);
+            if(activeCollisions.find(key) == activeCollisions.end()) {
+                catalog.destroySatellite(ev.sat1_id);
+                catalog.destroySatellite(ev.sat2_id);
+                collisionCount++;
+            }
+        }
+        activeCollisions = currentCollisions;
+        if(stageTimer) stageTimer->lap(STAGE_COLLISIONS);
+        
+        conjunctionUpdateTimer += frameDelta * controls.timeScale;
+        if(conjunctionUpdateTimer >= opts.interval) {
+            if(opts.fullRescan) analyzer.analyzeFutureConjunctions(catalog.getSatellites(), simTime, opts.window);
+            else analyzer.updateFutureConjunctions(catalog.getSatellites(), simTime, opts.window);
+            if(stageTimer) stageTimer->lap(STAGE_ANALYSIS);
+            exporter.submit(simTime, analyzer.getEvents());
+            if(stageTimer) stageTimer->lap(STAGE_EXPORT);
+            eventCount += analyzer.getEvents().size();
+            analysisCount++;
+            conjunctionUpdateTimer = 0.0f;
+        }
+        lastSimTime = simTime;
+        
+        // Periodic checkpoints are written in the background; one still being
+        // written postpones the next to a later step rather than stalling this one
+        if(!opts.checkpointPath.empty() && opts.checkpointEvery > 0.0f && simTime >= nextCheckpoint) {
+            if(checkpointWriter.save(opts.checkpointPath, captureState(simTime))) nextCheckpoint = simTime + opts.checkpointEvery;
+        }
+        timer.endFrame();
+    }
+    recorder.stop();
+    
+    if(!opts.checkpointPath.empty()) {
+        checkpointWriter.wait();
+        checkpointWriter.save(opts.checkpointPath, captureState(lastSimTime));
+        checkpointWriter.wait();
+    }
+    exporter.stop();
+    Log::Flush(); // Analysis messages before the summary
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    
+    std::cout << "\n=== HEADLESS RUN COMPLETE ===" << std::endl;
+    std::cout << "Analyses: " << analysisCount << " | Conjunction rows: " << eventCount
+              << " | Collisions: " << collisionCount << std::endl;
+    std::cout << "Wall time: " << wallSeconds << " s | Output: " << opts.outputPath;
+    if(exporter.getFileCount() > 1) std::cout << " (" << exporter.getFileCount() << " rotated files)";
+    std::cout << std::endl;
+    if(stageTimer) stageTimer->report(std::cout, wallSeconds);
+    return 0;
+}
@@ -1,5 +1,8 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <set>
 #include <glm/glm.hpp>
@@ -15,9 +18,15 @@
 #include "../scene/CollisionWarning.h"
 #include "../sim/CollisionDetect.h"
 #include "../sim/conjunctions/ConjunctionAnalyzer.h"
+#include "../sim/conjunctions/ConjunctionExporter.h"
 #include "../sim/ConjunctionVisualizer.h"
 #include "../ui/GuiManager.h"
+#include "../util/Checkpoint.h"
 #include "../util/ConfigLoader.h"
+#include "../util/Log.h"
+#include "../util/RunRecording.h"
+#include "../util/ScenarioBuilder.h"
+#include "../util/StageTimer.h"
 #include "imgui.h"
 
 // Settings
@@ -42,10 +51,13 @@ ConjunctionManager* colMan;
 CollisionWarningRenderer* warningRenderer;
 ConjunctionAnalyzer* conjunctionAnalyzer;
 ConjunctionVisualizer* conjunctionVis;
+ConjunctionExporter* conjunctionExporter = nullptr; // Only with --export
+CheckpointWriter* checkpointWriter;
 GuiManager* gui;
 
 // State
-float simTime = 0.0f;
+SimTime simTime = 0.0;
+double scenarioEpochJd = 0.0; // UTC of sim time 0 from the catalog, 0 if it has none
 float timeScale = 50.0f; // Start at 50x speed for faster observation 
 bool paused = false;
 int selectedSatId = -1;
@@ -56,9 +68,68 @@ bool cameraFollow = false;
 bool showConjunctions = true;
 float conjunctionUpdateTimer = 0.0f;
 float conjunctionUpdateInterval = 1.0f; // Update every 1 second (simulation time) for faster updates
+float conjunctionWindow = 3600.0f; // Look ahead 1 hour
 
 std::set<std::pair<int,int>> activeCollisions;
 
+const char* CHECKPOINT_PATH = "checkpoint.satckpt";
+
+// UI-driven state, as recorded and replayed once per frame
+RunControls captureControls() {
+    RunControls c;
+    c.simTime = simTime;
+    c.timeScale = timeScale;
+    c.paused = paused;
+    c.selectedSatId = selectedSatId;
+    c.viewFlags = (showOrbits ? VIEW_ORBITS : 0) | (showSatellites ? VIEW_SATELLITES : 0) |
+                  (showDebris ? VIEW_DEBRIS : 0) | (cameraFollow ? VIEW_CAMERA_FOLLOW : 0) |
+                  (showConjunctions ? VIEW_CONJUNCTIONS : 0);
+    return c;
+}
+
+void applyControls(const RunControls& c) {
+    simTime = c.simTime;
+    timeScale = c.timeScale;
+    paused = c.paused;
+    selectedSatId = c.selectedSatId;
+    showOrbits = (c.viewFlags & VIEW_ORBITS) != 0;
+    showSatellites = (c.viewFlags & VIEW_SATELLITES) != 0;
+    showDebris = (c.viewFlags & VIEW_DEBRIS) != 0;
+    cameraFollow = (c.viewFlags & VIEW_CAMERA_FOLLOW) != 0;
+    showConjunctions = (c.viewFlags & VIEW_CONJUNCTIONS) != 0;
+}
+
+// Copies the simulation state and hands it to the background writer (F5)
+void saveCheckpoint() {
+    CheckpointState ckpt;
+    ckpt.simTime = simTime;
+    ckpt.scenarioEpochJd = scenarioEpochJd;
+    ckpt.conjunctionTimer = conjunctionUpdateTimer;
+    ckpt.satellites = satSystem->toSatellites();
+    ckpt.particles = debrisSystem->getParticles();
+    ckpt.activeCollisions.assign(activeCollisions.begin(), activeCollisions.end());
+    ckpt.events = conjunctionAnalyzer->getEvents();
+    ckpt.screening = conjunctionAnalyzer->getScreeningState();
+    if(!checkpointWriter->save(CHECKPOINT_PATH, std::move(ckpt))) {
+        LOG_WARN("Checkpoint still being written, try again");
+    }
+}
+
+// Replaces the startup scenario with a saved one; false leaves the state untouched
+bool resumeCheckpoint(const char* path) {
+    Checkpoint ckpt;
+    if(!ckpt.open(path)) return false;
+    satSystem->addCatalog(ckpt.catalogView());
+    debrisSystem->restoreParticles(ckpt.particles(), ckpt.particleCount());
+    conjunctionAnalyzer->restoreState(ckpt.events(), ckpt.eventCount(), ckpt.getScreeningState());
+    for(const auto& pair : ckpt.getActiveCollisions()) activeCollisions.insert(pair);
+    simTime = ckpt.getSimTime();
+    scenarioEpochJd = ckpt.getScenarioEpochJd();
+    conjunctionUpdateTimer = ckpt.getConjunctionTimer();
+    LOG_INFO("Resumed " << path << " at t=" << simTime << " s");
+    return true;
+}
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
@@ -130,9 +201,86 @@ void processInput(GLFWwindow *window) {
     } else {
         cPressed = false;
     }
+    
+    static bool f5Pressed = false;
+    if (glfwGetKey(window, GLFW_KEY_F5) == GLFW_PRESS) {
+        if (!f5Pressed) {
+            saveCheckpoint();
+            f5Pressed = true;
+        }
+    } else {
+        f5Pressed = false;
+    }
 }
 
-int main() {
+void printUsage(const char* exe) {
+    std::cout << "Usage: " << exe << " [options]\n"
+              << "  --export <path>         Persist conjunction events\n"
+              << "  --export-format <fmt>   Export format: csv, jsonl or cdm (default csv)\n"
+              << "  --resume <path>         Start from a checkpoint saved with F5\n"
+              << "  --record <path>         Record frame deltas, controls and seeds to a .satrec file\n"
+              << "  --replay <path>         Replay a recording (app or headless) and time each stage\n"
+              << "  --cpu-satellites        Propagate satellite instances on the CPU (reference render)\n"
+              << "  --sampled-orbits        Draw orbit lines from paths sampled on the CPU\n";
+}
+
+int main(int argc, char** argv) {
+    const char* exportPath = nullptr;
+    const char* resumePath = nullptr;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    ConjunctionExporter::Format exportFormat = ConjunctionExporter::Format::CSV;
+    bool cpuSatellites = false;
+    bool sampledOrbits = false;
+    for(int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if(!strcmp(arg, "--help") || !strcmp(arg, "-h")) {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if(!strcmp(arg, "--cpu-satellites")) cpuSatellites = true;
+        else if(!strcmp(arg, "--sampled-orbits")) sampledOrbits = true;
+        else if(!strcmp(arg, "--export") && hasValue) exportPath = argv[++i];
+        else if(!strcmp(arg, "--resume") && hasValue) resumePath = argv[++i];
+        else if(!strcmp(arg, "--record") && hasValue) recordPath = argv[++i];
+        else if(!strcmp(arg, "--replay") && hasValue) replayPath = argv[++i];
+        else if(!strcmp(arg, "--export-format") && hasValue) {
+            if(!ConjunctionExporter::ParseFormat(argv[++i], exportFormat)) {
+                std::cerr << "Unknown export format: " << argv[i] << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Startup scenario; a replay brings its own
+    RunScenario scenario;
+    scenario.catalogPath = "assets/config/satellites.json";
+    scenario.collisionTest = true;
+    scenario.randomCount = 50; // Reduced to better see collision test satellites
+    scenario.scenarioSeed = 42;
+    scenario.debrisSeed = 43;
+    scenario.analysisInterval = conjunctionUpdateInterval;
+    scenario.analysisWindow = conjunctionWindow;
+    scenario.initialConjunctionTimer = conjunctionUpdateTimer;
+
+    RunReplay replay;
+    if(replayPath) {
+        if(!replay.open(replayPath)) return -1;
+        scenario = replay.getScenario();
+    }
+    if(resumePath && (recordPath || replayPath)) {
+        std::cout << "--record/--replay start from a scenario, ignoring --resume" << std::endl;
+        resumePath = nullptr;
+    }
+    
     if (!glfwInit()) return -1;
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -158,89 +306,47 @@ int main() {
 
     earth = new Earth();
     satSystem = new SatelliteSystem();
+    satSystem->setGpuPropagation(!cpuSatellites);
+    satSystem->setProceduralOrbits(!sampledOrbits);
     debrisSystem = new DebrisSystem();
     colMan = new ConjunctionManager();
     warningRenderer = new CollisionWarningRenderer();
     conjunctionAnalyzer = new ConjunctionAnalyzer();
     conjunctionVis = new ConjunctionVisualizer();
     gui = new GuiManager(window);
-
-    // Load satellites (Placeholder if file missing)
-    std::vector<Satellite> loadedSats = ConfigLoader::LoadSatellites("assets/config/satellites.json");
-    for(const auto& s : loadedSats) satSystem->addSatellite(s);
-
-    // ===== FORCED COLLISION TEST: Satellites start at SAME position! =====
-    // These satellites start at exactly the same point to trigger immediate collision warning
-    {
-        Satellite test1, test2;
-        
-        // Test satellite 1 - Very low LEO
-        test1.id = 9001;
-        test1.name = "COLLISION-SAT-A";
-        test1.semiMajorAxis = 6900.0f; // 529 km altitude - LOW orbit
-        test1.eccentricity = 0.0f;
-        test1.inclination = glm::radians(30.0f);
-        test1.raan = glm::radians(0.0f);
-        test1.argPeriapsis = glm::radians(0.0f);
-        test1.meanAnomaly = glm::radians(0.0f); // Starting at same position!
-        test1.color = glm::vec3(0.0f, 1.0f, 1.0f); // CYAN (Iridium-33 style)
-        
-        // Test satellite 2 - EXACT SAME POSITION (guaranteed collision at t=0!)
-        test2.id = 9002;
-        test2.name = "COLLISION-SAT-B";
-        test2.semiMajorAxis = 6900.0f; // Same altitude
-        test2.eccentricity = 0.0f;
-        test2.inclination = glm::radians(30.0f); // Same inclination
-        test2.raan = glm::radians(0.0f); // Same RAAN
-        test2.argPeriapsis = glm::radians(0.0f); // Same argument
-        test2.meanAnomaly = glm::radians(0.5f); // Almost same position (within 50km)
-        test2.color = glm::vec3(1.0f, 0.5f, 0.0f); // ORANGE (Cosmos-2251 style)
-        
-        satSystem->addSatellite(test1);
-        satSystem->addSatellite(test2);
+    checkpointWriter = new CheckpointWriter();
+
+    conjunctionUpdateInterval = scenario.analysisInterval;
+    conjunctionWindow = scenario.analysisWindow;
+    if(!resumePath || !resumeCheckpoint(resumePath)) {
+        // Load satellites (Placeholder if file missing)
+        if(!scenario.catalogPath.empty()) {
+            ConfigLoader::LoadInto(*satSystem, scenario.catalogPath, &scenarioEpochJd);
+        }
         
-        std::cout << "\n=== COLLISION TEST SATELLITES ADDED ===" << std::endl;
-        std::cout << "Sat 9001 (CYAN) and Sat 9002 (ORANGE) will collide!" << std::endl;
-        std::cout << "Watch for Conjunction Assessment Vectors!\n" << std::endl;
+        // Built-in test population
+        if(scenario.collisionTest) ScenarioBuilder::AddCollisionTestPair(*satSystem);
+        if(scenario.randomCount > 0) ScenarioBuilder::AddRandomSatellites(*satSystem, scenario.randomCount, scenario.scenarioSeed);
+        conjunctionUpdateTimer = scenario.initialConjunctionTimer;
     }
-
-    srand(42); 
-    int numSatellites = 50; // Reduced to better see collision test satellites
-    for(int i = 0; i < numSatellites; ++i) {
-        Satellite s;
-        s.id = 1000 + i;
-        
-        // Distribution: Realistic altitudes to prevent clipping through Earth
-        // 70% LEO (400-2000km altitude = 6771-8371km radius)
-        // 20% MEO (2000-35000km altitude)
-        // 10% GEO (35786km altitude)
-        int type = rand() % 100;
-        if (type < 70) {
-            // LEO: 400-2000 km altitude
-            s.semiMajorAxis = 6771.0f + (rand() % 1600);
-        } else if (type < 90) {
-            // MEO: 2000-35000 km altitude
-            s.semiMajorAxis = 8371.0f + (rand() % 32629);
-        } else {
-            // GEO: ~35786 km altitude (42157 km radius)
-            s.semiMajorAxis = 42157.0f + (rand() % 200);
+    srand(scenario.debrisSeed); // Debris spread, recorded with the run
+
+    if(exportPath) {
+        // Each encounter is written once, in 64 MB files; a full queue drops events rather than stall a frame.
+        // Started once the catalog is loaded, so CDM dates use its epoch.
+        conjunctionExporter = new ConjunctionExporter();
+        conjunctionExporter->setOnlyChanges(true);
+        conjunctionExporter->setMaxFileBytes(64u * 1024u * 1024u);
+        conjunctionExporter->setScenarioEpochJd(scenarioEpochJd);
+        if(!conjunctionExporter->start(exportPath, exportFormat)) {
+            delete conjunctionExporter;
+            conjunctionExporter = nullptr;
         }
-
-        s.eccentricity = (rand() % 50) / 1000.0f; // Very low eccentricity
-        s.inclination = glm::radians((float)(rand() % 180));
-        s.raan = glm::radians((float)(rand() % 360));
-        s.argPeriapsis = glm::radians((float)(rand() % 360));
-        s.meanAnomaly = glm::radians((float)(rand() % 360));
-        
-        // Color for orbit lines
-        float alt = s.semiMajorAxis - 6371.0f;
-        if (alt < 2000) s.color = glm::vec3(0.4, 0.8, 1.0); // Cyan for LEO
-        else if (alt < 30000) s.color = glm::vec3(0.4, 1.0, 0.4); // Green for MEO
-        else s.color = glm::vec3(1.0, 0.4, 0.4); // Red for GEO
-        
-        satSystem->addSatellite(s);
     }
 
+    RunRecorder recorder;
+    if(recordPath) recorder.start(recordPath, scenario);
+
     // Initialize orbit paths after adding all satellites
     satSystem->initOrbits();
 
@@ -256,37 +362,66 @@ int main() {
 
     camera.IsOrbiting = true;
 
+    // Replays run unthrottled (no vsync) on the recorded clock and time each stage
+    enum { STAGE_PROPAGATE, STAGE_COLLISIONS, STAGE_ANALYSIS, STAGE_EFFECTS, STAGE_RENDER };
+    StageTimer timer({"propagate", "collisions", "analysis", "effects", "render"});
+    StageTimer* stageTimer = nullptr;
+    float replayClock = 0.0f;
+    if(replay.isOpen()) {
+        stageTimer = &timer;
+        glfwSwapInterval(0);
+        LOG_INFO("Replaying " << replayPath << " (" << replay.getRecordedFrames() << " frames)");
+    }
+    auto wallStart = std::chrono::steady_clock::now();
+
     while (!glfwWindowShouldClose(window)) {
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+        float currentFrame;
+        if(replay.isOpen()) {
+            RunControls controls = captureControls();
+            if(!replay.nextFrame(deltaTime, controls)) break;
+            applyControls(controls);
+            replayClock += deltaTime;
+            currentFrame = replayClock;
+        } else {
+            currentFrame = static_cast<float>(glfwGetTime());
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+            if (!paused) simTime += deltaTime * timeScale;
+            recorder.frame(deltaTime, captureControls());
+        }
+        if(stageTimer) stageTimer->startFrame();
 
         gui->NewFrame();
 
         earth->Update(deltaTime);
+        if(stageTimer) stageTimer->lap(STAGE_EFFECTS);
 
         if (!paused) {
-            simTime += deltaTime * timeScale;
             satSystem->update(simTime);
+            if(stageTimer) stageTimer->lap(STAGE_PROPAGATE);
             colMan->update(satSystem->getSatellites(), simTime);
             
             // Update collision warnings
             const auto& predictions = colMan->getPredictions();
             warningRenderer->update(predictions, currentFrame);
+            if(stageTimer) stageTimer->lap(STAGE_COLLISIONS);
             
             // Conjunction analysis (periodic update for performance)
             conjunctionUpdateTimer += deltaTime * timeScale;
             if(conjunctionUpdateTimer >= conjunctionUpdateInterval) {
-                conjunctionAnalyzer->analyzeFutureConjunctions(
+                conjunctionAnalyzer->updateFutureConjunctions(
                     satSystem->getSatellites(),
                     simTime,
-                    3600.0f // Look ahead 1 hour
+                    conjunctionWindow
                 );
+                if(conjunctionExporter) conjunctionExporter->submit(simTime, conjunctionAnalyzer->getEvents());
                 conjunctionUpdateTimer = 0.0f;
+                if(stageTimer) stageTimer->lap(STAGE_ANALYSIS);
             }
             
             // Update conjunction visualization
             conjunctionVis->update(conjunctionAnalyzer->getEvents(), currentFrame);
+            if(stageTimer) stageTimer->lap(STAGE_EFFECTS);
             
             const auto& events = colMan->getEvents();
             std::set<std::pair<int,int>> currentCollisions;
@@ -295,17 +430,12 @@ int main() {
                 currentCollisions.insert(key);
                 if(activeCollisions.find(key) == activeCollisions.end()) {
                     // New collision
-                    const auto& satellites = satSystem->getSatellites();
-                    glm::vec3 p1, p2, v1, v2, c1, c2;
-                    bool f1=false, f2=false;
-                    for(const auto& s : satellites) {
-                        if(s.id == ev.sat1_id) { p1 = s.position; v1 = s.velocity; c1 = s.color; f1=true; }
-                        if(s.id == ev.sat2_id) { p2 = s.position; v2 = s.velocity; c2 = s.color; f2=true; }
-                    }
-                    if(f1 && f2) {
-                        glm::vec3 mid = (p1 + p2) * 0.5f;
+                    auto s1 = satSystem->findById(ev.sat1_id);
+                    auto s2 = satSystem->findById(ev.sat2_id);
+                    if(s1 && s2) {
+                        glm::vec3 mid = (s1->position() + s2->position()) * 0.5f;
                         // Pass separate velocities for correct "butterfly" cloud shape
-                        debrisSystem->addExplosion(mid, v1, v2, c1, c2);
+                        debrisSystem->addExplosion(mid, s1->velocity(), s2->velocity(), s1->color(), s2->color());
                         
                         // Destroy satellites (remove from map)
                         satSystem->destroySatellite(ev.sat1_id);
@@ -314,24 +444,23 @@ int main() {
                 }
             }
             activeCollisions = currentCollisions;
+            if(stageTimer) stageTimer->lap(STAGE_COLLISIONS);
         }
 
         debrisSystem->update(deltaTime);
 
         if (cameraFollow && selectedSatId != -1) {
-            const auto& satellites = satSystem->getSatellites();
-            for(const auto& s : satellites) {
-                if(s.id == selectedSatId) {
-                    glm::vec3 targetPos = s.position * (1.0f / 6371.0f); // Scale down to visual earth
-                    if(camera.IsOrbiting) camera.Target = targetPos;
-                    else camera.Position = targetPos + glm::vec3(0.0f, 0.1f, 0.1f);
-                    break;
-                }
+            if(auto s = satSystem->findById(selectedSatId)) {
+                glm::vec3 targetPos = s->position() * (1.0f / 6371.0f); // Scale down to visual earth
+                if(camera.IsOrbiting) camera.Target = targetPos;
+                else camera.Position = targetPos + glm::vec3(0.0f, 0.1f, 0.1f);
             }
         } else if (camera.IsOrbiting) {
             camera.Target = glm::vec3(0.0f);
         }
 
+        if(stageTimer) stageTimer->lap(STAGE_EFFECTS);
+
         processInput(window);
 
         glClearColor(0.0f, 0.0f, 0.02f, 1.0f);
@@ -358,7 +487,19 @@ int main() {
 
         glfwSwapBuffers(window);
         glfwPollEvents();
+        if(stageTimer) {
+            glFinish(); // Charge the GPU work to this frame
+            stageTimer->lap(STAGE_RENDER);
+            stageTimer->endFrame();
+        }
+    }
+
+    if(stageTimer) {
+        double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        Log::Flush(); // Analysis messages before the report
+        stageTimer->report(std::cout, wallSeconds);
     }
+    recorder.stop();
 
     delete earth;
     delete satSystem;
@@ -367,6 +508,8 @@ int main() {
     delete warningRenderer;
     delete conjunctionAnalyzer;
     delete conjunctionVis;
+    delete conjunctionExporter; // Writes out what is still queued
+    delete checkpointWriter; // Finishes a checkpoint in progress
     delete gui;
     glfwTerminate();
     return 0;
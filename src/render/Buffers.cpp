@@ -1,4 +1,6 @@
 #include "Buffers.h"
+#include <cstring>
+#include "../util/Log.h"
 
 VBO::VBO(std::vector<Vertex>& vertices) {
     glGenBuffers(1, &ID);
@@ -34,3 +36,102 @@ EBO::EBO(std::vector<unsigned int>& indices) {
 void EBO::bind() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID); }
 void EBO::unbind() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
 void EBO::remove() { glDeleteBuffers(1, &ID); }
+
+StreamBuffer::StreamBuffer(GLsizeiptr regionSize) : persistent(persistentMappingSupported()), regionSize(0) {
+    allocate(regionSize);
+}
+
+bool StreamBuffer::persistentMappingSupported() {
+    return GLEW_ARB_buffer_storage || GLEW_VERSION_4_4;
+}
+
+void StreamBuffer::allocate(GLsizeiptr minRegionSize) {
+    // Doubling keeps growth rare; 256 bytes satisfies any attribute alignment
+    GLsizeiptr size = regionSize > 0 ? regionSize : 256;
+    while(size < minRegionSize) size *= 2;
+    size = (size + 255) & ~(GLsizeiptr)255;
+    
+    if(ID != 0) remove();
+    regionSize = size;
+    region = Regions - 1;
+    
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_ARRAY_BUFFER, ID);
+    if(persistent) {
+        // Immutable storage cannot be resized, so growing creates a new buffer
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, regionSize * Regions, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, regionSize * Regions, flags));
+        if(!mapped) {
+            LOG_WARN("StreamBuffer: persistent mapping failed, falling back to orphaning");
+            persistent = false;
+            glDeleteBuffers(1, &ID);
+            glGenBuffers(1, &ID);
+            glBindBuffer(GL_ARRAY_BUFFER, ID);
+        }
+    }
+    if(!persistent) {
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamBuffer::waitRegion(int index) {
+    GLsync& fence = fences[index];
+    if(!fence) return;
+    
+    // Flush on the first wait so the fence is guaranteed to be reached
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    for(;;) {
+        GLenum result = glClientWaitSync(fence, flags, 1000000000); // 1 s
+        if(result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) break;
+        if(result == GL_WAIT_FAILED) {
+            LOG_ERROR("StreamBuffer: glClientWaitSync failed");
+            break;
+        }
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+GLintptr StreamBuffer::upload(const void* data, GLsizeiptr size) {
+    if(size > regionSize) allocate(size);
+    
+    if(!persistent) {
+        // Orphan: the driver hands out fresh storage while frames in flight keep the old one
+        glBindBuffer(GL_ARRAY_BUFFER, ID);
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return 0;
+    }
+    
+    // Draws reading the previous region were issued since its upload; fence them
+    if(!fences[region]) fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    
+    region = (region + 1) % Regions;
+    waitRegion(region);
+    
+    GLintptr offset = region * regionSize;
+    std::memcpy(mapped + offset, data, size);
+    return offset;
+}
+
+void StreamBuffer::bind() { glBindBuffer(GL_ARRAY_BUFFER, ID); }
+void StreamBuffer::unbind() { glBindBuffer(GL_ARRAY_BUFFER, 0); }
+
+void StreamBuffer::remove() {
+    for(GLsync& fence : fences) {
+        if(fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if(mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, ID);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mapped = nullptr;
+    }
+    glDeleteBuffers(1, &ID);
+    ID = 0;
+}
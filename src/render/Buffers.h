@@ -35,3 +35,36 @@ public:
     void unbind();
     void remove();
 };
+
+// Ring of vertex storage for data rewritten every frame. upload() copies into
+// the next of three regions and returns the byte offset the attribute pointers
+// should use; the caller rebinds them after each upload (ID can change when
+// the buffer grows).
+//
+// With GL_ARB_buffer_storage the buffer is persistently mapped: the CPU writes
+// straight into one region while the GPU may still read the other two, and a
+// fence per region only blocks if the CPU gets three frames ahead. Without it,
+// each upload orphans the storage and refills it with glBufferSubData.
+class StreamBuffer {
+public:
+    unsigned int ID = 0;
+    StreamBuffer(GLsizeiptr regionSize = 64 * 1024);
+    GLintptr upload(const void* data, GLsizeiptr size);
+    void bind();
+    void unbind();
+    void remove();
+    
+    static bool persistentMappingSupported();
+
+private:
+    static constexpr int Regions = 3;
+    
+    bool persistent;
+    GLsizeiptr regionSize;
+    int region = Regions - 1; // Region written by the last upload
+    unsigned char* mapped = nullptr;
+    GLsync fences[Regions] = {};
+    
+    void allocate(GLsizeiptr minRegionSize);
+    void waitRegion(int index);
+};
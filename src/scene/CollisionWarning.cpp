@@ -1,17 +1,14 @@
 #include "CollisionWarning.h"
 #include <GL/glew.h>
 #include <cmath>
-#include <iostream>
+#include "../util/Log.h"
 
 CollisionWarningRenderer::CollisionWarningRenderer() {
     warningShader = new Shader("shaders/warning.vert", "shaders/warning.frag");
     animTime = 0.0f;
     
     glGenVertexArrays(1, &trajectoryVAO);
-    glGenBuffers(1, &trajectoryVBO);
-    
     glGenVertexArrays(1, &impactVAO);
-    glGenBuffers(1, &impactVBO);
     
     trajectoryVertexCount = 0;
     impactVertexCount = 0;
@@ -20,9 +17,9 @@ CollisionWarningRenderer::CollisionWarningRenderer() {
 CollisionWarningRenderer::~CollisionWarningRenderer() {
     delete warningShader;
     glDeleteVertexArrays(1, &trajectoryVAO);
-    glDeleteBuffers(1, &trajectoryVBO);
+    trajectoryStream.remove();
     glDeleteVertexArrays(1, &impactVAO);
-    glDeleteBuffers(1, &impactVBO);
+    impactStream.remove();
 }
 
 void CollisionWarningRenderer::update(const std::vector<CollisionPrediction>& predictions, float time) {
@@ -36,13 +33,13 @@ void CollisionWarningRenderer::update(const std::vector<CollisionPrediction>& pr
         return;
     }
     
-    std::cout << "CollisionWarning: Updating " << predictions.size() << " predictions" << std::endl;
+    LOG_DEBUG_RATE(1, "CollisionWarning: Updating " << predictions.size() << " predictions");
     
     for(const auto& pred : predictions) {
         if(!pred.isActive) continue;
         
-        std::cout << "  -> Sat " << pred.satelliteId << " trajectory with " 
-                  << pred.trajectoryPoints.size() << " points" << std::endl;
+        LOG_TRACE_RATE(10, "  -> Sat " << pred.satelliteId << " trajectory with "
+                  << pred.trajectoryPoints.size() << " points");
         
         // Generate trajectory line (BRIGHT red line from collision to impact)
         for(size_t i = 0; i < pred.trajectoryPoints.size(); ++i) {
@@ -69,14 +66,14 @@ void CollisionWarningRenderer::update(const std::vector<CollisionPrediction>& pr
     // Upload trajectory data
     trajectoryVertexCount = trajectoryData.size() / 6;
     if(trajectoryVertexCount > 0) {
+        GLintptr offset = trajectoryStream.upload(trajectoryData.data(), trajectoryData.size() * sizeof(float));
         glBindVertexArray(trajectoryVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, trajectoryVBO);
-        glBufferData(GL_ARRAY_BUFFER, trajectoryData.size() * sizeof(float), trajectoryData.data(), GL_DYNAMIC_DRAW);
+        trajectoryStream.bind();
         
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)offset);
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(offset + 3 * sizeof(float)));
         
         glBindVertexArray(0);
     }
@@ -84,14 +81,14 @@ void CollisionWarningRenderer::update(const std::vector<CollisionPrediction>& pr
     // Upload impact marker data
     impactVertexCount = impactMarkers.size() / 6;
     if(impactVertexCount > 0) {
+        GLintptr offset = impactStream.upload(impactMarkers.data(), impactMarkers.size() * sizeof(float));
         glBindVertexArray(impactVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, impactVBO);
-        glBufferData(GL_ARRAY_BUFFER, impactMarkers.size() * sizeof(float), impactMarkers.data(), GL_DYNAMIC_DRAW);
+        impactStream.bind();
         
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)offset);
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(offset + 3 * sizeof(float)));
         
         glBindVertexArray(0);
     }
@@ -177,8 +174,8 @@ void CollisionWarningRenderer::draw(const glm::mat4& view, const glm::mat4& proj
     if(trajectoryVertexCount > 0) {
         // Debug first vertex to check coordinates
         if(trajectoryData.size() >= 3) {
-            std::cout << "Draw Warning Line: Start Pos (" 
-                      << trajectoryData[0] << ", " << trajectoryData[1] << ", " << trajectoryData[2] << ")" << std::endl;
+            LOG_TRACE_RATE(1, "Draw Warning Line: Start Pos ("
+                      << trajectoryData[0] << ", " << trajectoryData[1] << ", " << trajectoryData[2] << ")");
         }
 
         glBindVertexArray(trajectoryVAO);
@@ -2,6 +2,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "../render/Shader.h"
+#include "../render/Buffers.h"
 #include "../sim/CollisionDetect.h"
 
 class CollisionWarningRenderer {
@@ -14,8 +15,8 @@ public:
     
 private:
     Shader* warningShader;
-    unsigned int trajectoryVAO, trajectoryVBO;
-    unsigned int impactVAO, impactVBO;
+    unsigned int trajectoryVAO, impactVAO;
+    StreamBuffer trajectoryStream, impactStream;
     
     std::vector<float> trajectoryData;
     std::vector<float> impactMarkers;
@@ -3,22 +3,21 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 #include <algorithm>
-#include <iostream>
+#include "../util/Log.h"
 
 DebrisSystem::DebrisSystem() {
     shader = new Shader("shaders/warning.vert", "shaders/warning.frag"); 
     glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
 }
 
 DebrisSystem::~DebrisSystem() {
     delete shader;
     glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    stream.remove();
 }
 
 // Helper to generate a burst of debris for one object
-void generateBurst(std::vector<Particle>& particles, glm::vec3 pos, glm::vec3 vel, glm::vec3 color, int count) {
+void generateBurst(ParticlePool& particles, glm::vec3 pos, glm::vec3 vel, glm::vec3 color, int count) {
     glm::vec3 forward = glm::normalize(vel);
     glm::vec3 up = glm::normalize(pos); // Radial
     glm::vec3 right = glm::cross(forward, up); // Cross-track
@@ -49,7 +48,10 @@ void generateBurst(std::vector<Particle>& particles, glm::vec3 pos, glm::vec3 ve
         p.life = 12.0f; // 12 seconds (not 7, but visible long enough)
         p.maxLife = 12.0f;
         
-        particles.push_back(p);
+        if(!particles.spawn(p)) {
+            LOG_WARN_RATE(1, "Debris pool full (" << particles.capacity() << " particles), dropping " << count - i);
+            return;
+        }
     }
 }
 
@@ -59,9 +61,9 @@ void DebrisSystem::addExplosion(glm::vec3 position, glm::vec3 v1, glm::vec3 v2,
     glm::vec3 renderV1 = v1 * (1.0f / 6371.0f); 
     glm::vec3 renderV2 = v2 * (1.0f / 6371.0f); 
     
-    std::cout << "EXPLOSION GENERATED at (" << renderPos.x << ", " << renderPos.y << ", " << renderPos.z << ")" << std::endl;
-    std::cout << "  V1: (" << renderV1.x << ", " << renderV1.y << ", " << renderV1.z << ")" << std::endl;
-    std::cout << "  V2: (" << renderV2.x << ", " << renderV2.y << ", " << renderV2.z << ")" << std::endl;
+    LOG_INFO_RATE(10, "EXPLOSION GENERATED at (" << renderPos.x << ", " << renderPos.y << ", " << renderPos.z << ")");
+    LOG_DEBUG_RATE(10, "  V1: (" << renderV1.x << ", " << renderV1.y << ", " << renderV1.z << ")"
+                   << "  V2: (" << renderV2.x << ", " << renderV2.y << ", " << renderV2.z << ")");
     
     // Burst 1: Based on Sat 1 Velocity (e.g., Cyan) - FEWER particles
     generateBurst(particles, renderPos, renderV1, color1, 500);
@@ -69,21 +71,23 @@ void DebrisSystem::addExplosion(glm::vec3 position, glm::vec3 v1, glm::vec3 v2,
     // Burst 2: Based on Sat 2 Velocity (e.g., Orange) - FEWER particles
     generateBurst(particles, renderPos, renderV2, color2, 500);
     
-    std::cout << "  Total particles: " << particles.size() << std::endl;
+    LOG_DEBUG_RATE(10, "  Total particles: " << particles.size());
 }
 
 void DebrisSystem::update(float deltaTime) {
     // DISABLE gravity - in space, debris continues in straight lines for visualization
     // Gravity makes them fall away too fast and leaves the viewport
     
-    for(auto it = particles.begin(); it != particles.end(); ) {
-        it->life -= deltaTime;
-        if(it->life <= 0) {
-            it = particles.erase(it);
-        } else {
-            // Just linear motion - NO gravity for better visibility
-            it->position += it->velocity * deltaTime;
-            ++it;
+    // Just linear motion - NO gravity for better visibility
+    particles.update(deltaTime);
+}
+
+void DebrisSystem::restoreParticles(const Particle* data, size_t count) {
+    particles.clear();
+    for(size_t i = 0; i < count; ++i) {
+        if(!particles.spawn(data[i])) {
+            LOG_WARN("Checkpoint has " << count << " debris particles, keeping " << particles.capacity());
+            break;
         }
     }
 }
@@ -99,35 +103,34 @@ void DebrisSystem::draw(const glm::mat4& view, const glm::mat4& projection) {
     shader->setMat4("projection", projection);
     shader->setMat4("model", glm::mat4(1.0f));
     
-    std::vector<float> data;
-    data.reserve(particles.size() * 12); 
+    lineData.resize(particles.size() * 12);
+    float* v = lineData.data();
     
-    for(const auto& p : particles) {
-        glm::vec3 start = p.position;
+    for(size_t i = 0; i < particles.size(); ++i, v += 12) {
+        glm::vec3 start = particles.position(i);
         // Shorter vectors for compact visualization
         float vectorScale = 3.0f; // Reduced for smaller explosion
-        glm::vec3 end = p.position + p.velocity * vectorScale; 
-        
-        // Fade based on remaining life
-        float alpha = p.life / p.maxLife;
+        glm::vec3 end = start + particles.velocity(i) * vectorScale;
+        const glm::vec3& color = particles.colors[i];
         
         // Start (bright)
-        data.push_back(start.x); data.push_back(start.y); data.push_back(start.z);
-        data.push_back(p.color.r); data.push_back(p.color.g); data.push_back(p.color.b);
+        v[0] = start.x; v[1] = start.y; v[2] = start.z;
+        v[3] = color.r; v[4] = color.g; v[5] = color.b;
         
         // End (same brightness for solid look)
-        data.push_back(end.x); data.push_back(end.y); data.push_back(end.z);
-        data.push_back(p.color.r); data.push_back(p.color.g); data.push_back(p.color.b);
+        v[6] = end.x; v[7] = end.y; v[8] = end.z;
+        v[9] = color.r; v[10] = color.g; v[11] = color.b;
     }
     
+    GLintptr offset = stream.upload(lineData.data(), lineData.size() * sizeof(float));
+    
     glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_DYNAMIC_DRAW);
+    stream.bind();
     
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)offset);
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(offset + 3 * sizeof(float)));
     
     // Medium thickness lines
     glLineWidth(2.0f); 
@@ -2,15 +2,9 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "../render/Shader.h"
-
-struct Particle {
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec3 color;
-    float size;
-    float life;
-    float maxLife;
-};
+#include "../render/Buffers.h"
+#include "Particle.h"
+#include "ParticlePool.h"
 
 class DebrisSystem {
 public:
@@ -23,8 +17,14 @@ public:
     void update(float deltaTime);
     void draw(const glm::mat4& view, const glm::mat4& projection);
     
+    // Checkpoint support
+    std::vector<Particle> getParticles() const { return particles.toParticles(); }
+    void restoreParticles(const Particle* data, size_t count);
+    
 private:
-    std::vector<Particle> particles;
+    ParticlePool particles;
+    std::vector<float> lineData; // Reused by draw()
     Shader* shader;
-    unsigned int VAO, VBO;
+    unsigned int VAO;
+    StreamBuffer stream;
 };
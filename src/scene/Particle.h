@@ -0,0 +1,12 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Debris particle (render space), kept free of GL so checkpoints can store it
+struct Particle {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 color;
+    float size;
+    float life;
+    float maxLife;
+};
@@ -0,0 +1,82 @@
+#include "ParticlePool.h"
+
+namespace {
+// values[i] += rates[i] * dt
+void advance(float* values, const float* rates, float dt, size_t n) {
+    for(size_t i = 0; i < n; ++i) values[i] += rates[i] * dt;
+}
+}
+
+ParticlePool::ParticlePool(size_t capacity)
+    : x(capacity), y(capacity), z(capacity)
+    , vx(capacity), vy(capacity), vz(capacity)
+    , life(capacity)
+    , colors(capacity), sizes(capacity), maxLife(capacity)
+{
+}
+
+bool ParticlePool::spawn(const Particle& p) {
+    if(count == capacity()) return false;
+    
+    size_t i = count++;
+    x[i] = p.position.x; y[i] = p.position.y; z[i] = p.position.z;
+    vx[i] = p.velocity.x; vy[i] = p.velocity.y; vz[i] = p.velocity.z;
+    life[i] = p.life;
+    colors[i] = p.color;
+    sizes[i] = p.size;
+    maxLife[i] = p.maxLife;
+    return true;
+}
+
+void ParticlePool::update(float deltaTime) {
+    size_t n = count;
+    
+    // One array per loop: a single load/store stream each, which the compiler
+    // vectorizes after a cheap overlap check (fused, the pairwise alias
+    // checks between seven arrays defeat it)
+    advance(x.data(), vx.data(), deltaTime, n);
+    advance(y.data(), vy.data(), deltaTime, n);
+    advance(z.data(), vz.data(), deltaTime, n);
+    float* remaining = life.data();
+    for(size_t i = 0; i < n; ++i) remaining[i] -= deltaTime;
+    
+    // Swap-and-pop: one pass and at most one move per expired particle, however
+    // many expire together (erasing from the middle shifted the whole tail)
+    size_t i = 0;
+    while(i < n) {
+        if(life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        --n;
+        if(i != n) moveSlot(n, i);
+    }
+    count = n;
+}
+
+void ParticlePool::moveSlot(size_t from, size_t to) {
+    x[to] = x[from]; y[to] = y[from]; z[to] = z[from];
+    vx[to] = vx[from]; vy[to] = vy[from]; vz[to] = vz[from];
+    life[to] = life[from];
+    colors[to] = colors[from];
+    sizes[to] = sizes[from];
+    maxLife[to] = maxLife[from];
+}
+
+Particle ParticlePool::get(size_t i) const {
+    Particle p;
+    p.position = position(i);
+    p.velocity = velocity(i);
+    p.color = colors[i];
+    p.size = sizes[i];
+    p.life = life[i];
+    p.maxLife = maxLife[i];
+    return p;
+}
+
+std::vector<Particle> ParticlePool::toParticles() const {
+    std::vector<Particle> particles;
+    particles.reserve(count);
+    for(size_t i = 0; i < count; ++i) particles.push_back(get(i));
+    return particles;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../util/AlignedAllocator.h"
+#include "Particle.h"
+
+// Debris particles in structure-of-arrays form with a fixed capacity, all
+// allocated up front so a burst of breakups never reallocates mid-frame.
+// Live particles are packed into [0, size()): dead ones are retired by moving
+// the last live particle into their slot, so order is not preserved.
+//
+// Hot (every frame): position, velocity and remaining life, integrated as
+// plain float arrays the compiler vectorizes. Cold: colour, size, lifetime.
+struct ParticlePool {
+    static constexpr size_t DEFAULT_CAPACITY = 32768; // 32 simultaneous 1000-particle breakups
+    
+    AlignedVector<float> x, y, z;    // Render space
+    AlignedVector<float> vx, vy, vz; // Render space per second
+    AlignedVector<float> life;       // Seconds left
+    
+    std::vector<glm::vec3> colors;
+    std::vector<float> sizes;
+    std::vector<float> maxLife;
+    
+    explicit ParticlePool(size_t capacity = DEFAULT_CAPACITY);
+    
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return life.size(); }
+    
+    void clear() { count = 0; }
+    bool spawn(const Particle& p); // False (particle dropped) when the pool is full
+    void update(float deltaTime);  // Integrate, then retire expired particles
+    
+    glm::vec3 position(size_t i) const { return glm::vec3(x[i], y[i], z[i]); }
+    glm::vec3 velocity(size_t i) const { return glm::vec3(vx[i], vy[i], vz[i]); }
+    
+    Particle get(size_t i) const; // Reassembled copy (checkpoints)
+    std::vector<Particle> toParticles() const;
+
+private:
+    size_t count = 0;
+    
+    void moveSlot(size_t from, size_t to);
+};
@@ -1,10 +1,25 @@
 #pragma once
 #include <string>
+#include <memory>
 #include <glm/glm.hpp>
 
+struct Sgp4Record;
+
+// Keplerian elements as loaded (km, radians); what the exact propagation needs
+struct OrbitElements {
+    float semiMajorAxis;
+    float eccentricity;
+    float inclination;
+    float raan;
+    float argPeriapsis;
+    float meanAnomaly;   // At epoch (sim time 0)
+};
+
+// One catalog entry as loaded or saved. The simulation keeps these split
+// into SoA tables (SatelliteStore); this is the interchange form.
 struct Satellite {
-    std::string name;
     int id;
+    std::string name;
 
     // Keplerian Elements (Units: km, radians)
     float semiMajorAxis; // a (km)
@@ -13,13 +28,21 @@ struct Satellite {
     float raan;          // Omega (Long. of Ascending Node) (radians)
     float argPeriapsis;  // omega (Argument of Periapsis) (radians)
     float meanAnomaly;   // M0 (radians) at epoch
-    float meanMotion;    // n (radians/sec) - if not provided, computed from a
+
+    // Set for objects loaded from TLEs: propagated with SGP4 instead of the
+    // two-body elements above (which are kept as a mean-element approximation)
+    std::shared_ptr<const Sgp4Record> sgp4;
 
     // State
     glm::vec3 position;  // ECI position (km)
     glm::vec3 velocity;  // ECI velocity (km/s)
-    
+
     // Visualization
     glm::vec3 color;
-};
 
+    bool active = true; // For destroying satellites
+
+    OrbitElements elements() const {
+        return {semiMajorAxis, eccentricity, inclination, raan, argPeriapsis, meanAnomaly};
+    }
+};
@@ -1,70 +1,144 @@
 #include "SatelliteSystem.h"
 #include "../sim/OrbitPropagator.h"
 #include <GL/glew.h>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <iostream>
 
+namespace {
+// instanceStream entry (CPU path)
+struct CpuInstance {
+    float position[3]; // Earth radii
+    float color[3];
+    int32_t id;        // Beacon blink rate
+};
+
+// keplerVBO entry (GPU path), written once per catalog slot
+struct KeplerInstance {
+    float orbit[4];    // a (km), e, sqrt(1 - e^2), mean motion (rad/s)
+    float axisP[3];    // Perifocal axes, render frame
+    float axisQ[3];
+    float color[3];
+    int32_t id;
+};
+
+static_assert(sizeof(CpuInstance) == 7 * sizeof(float), "satellite.vert instance layout");
+static_assert(sizeof(KeplerInstance) == 14 * sizeof(float), "satellite.vert instance layout");
+
+// Procedural orbit detail: power-of-two segment counts from 16 to 1024,
+// enough that a segment spans about this many pixels on screen
+const int ORBIT_LOD_LEVELS = 7;
+const int ORBIT_MIN_SEGMENTS = 16;
+const float ORBIT_PIXELS_PER_SEGMENT = 6.0f;
+}
+
 SatelliteSystem::SatelliteSystem() {
     satShader = new Shader("shaders/satellite.vert", "shaders/satellite.frag");
     orbitShader = new Shader("shaders/orbit.vert", "shaders/orbit.frag");
+    ellipseShader = new Shader("shaders/orbit_procedural.vert", "shaders/orbit.frag");
     initRenderData();
 }
 
 SatelliteSystem::~SatelliteSystem() {
     delete satShader;
     delete orbitShader;
+    delete ellipseShader;
     glDeleteVertexArrays(1, &satVAO);
     glDeleteBuffers(1, &satVBO);
     glDeleteBuffers(1, &satEBO);
-    glDeleteBuffers(1, &satInstanceVBO);
+    instanceStream.remove();
+    glDeleteVertexArrays(1, &keplerVAO);
+    glDeleteBuffers(1, &keplerVBO);
+    glDeleteBuffers(1, &keplerPhaseVBO);
     glDeleteVertexArrays(1, &orbitVAO);
     glDeleteBuffers(1, &orbitVBO);
+    glDeleteVertexArrays(1, &ellipseVAO);
+    glDeleteBuffers(1, &ellipseTBO);
+    glDeleteTextures(1, &ellipseTexture);
+    ellipseSlotStream.remove();
 }
 
-void SatelliteSystem::addSatellite(const Satellite& sat) {
-    satellites.push_back(sat);
+void SatelliteSystem::update(SimTime time) {
+    // Collision checks need every position on the CPU, whichever path draws them
+    propagate(time);
+    renderTime = time;
+    
+    if(gpuPropagation) syncKeplerInstances();
+    
+    // CPU path: active satellites the shader does not propagate
+    std::vector<CpuInstance> instanceData;
+    instanceData.reserve(gpuPropagation ? satellites.elements.sgp4Index.size() : satellites.activeCount());
+    satellites.active.forEach([&](size_t i) {
+        if(drawsOnGpu(i)) return;
+        
+        glm::vec3 renderPos = satellites.position(i) * (1.0f / 6371.0f);
+        const glm::vec3& color = satellites.colors[i];
+        instanceData.push_back({{renderPos.x, renderPos.y, renderPos.z}, {color.r, color.g, color.b}, satellites.ids[i]});
+    });
+    cpuInstanceCount = (int)instanceData.size();
+    if(cpuInstanceCount == 0) return;
+    
+    GLintptr offset = instanceStream.upload(instanceData.data(), instanceData.size() * sizeof(CpuInstance));
+    glBindVertexArray(satVAO);
+    pointCpuInstances(offset);
+    glBindVertexArray(0);
 }
 
-void SatelliteSystem::destroySatellite(int id) {
-    for(auto& sat : satellites) {
-        if(sat.id == id) {
-            sat.active = false;
-            std::cout << "Satellite " << id << " destroyed and removed from map." << std::endl;
-            break;
-        }
-    }
+// Instance attributes of satVAO (bound) at the given instanceStream offset
+void SatelliteSystem::pointCpuInstances(GLintptr offset) {
+    instanceStream.bind();
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(CpuInstance), (void*)(offset + offsetof(CpuInstance, position)));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(CpuInstance), (void*)(offset + offsetof(CpuInstance, color)));
+    glVertexAttribIPointer(4, 1, GL_INT, sizeof(CpuInstance), (void*)(offset + offsetof(CpuInstance, id)));
+    instanceStream.unbind();
 }
 
-void SatelliteSystem::update(float time) {
-    std::vector<float> instanceData;
-    instanceData.reserve(satellites.size() * 7); // pos(3) + color(3) + beaconState(1)
-    
-    for(auto& sat : satellites) {
-        OrbitPropagator::Propagate(sat, time);
-        
-        // Only add to instance buffer if active
-        if(!sat.active) continue;
-
-        glm::vec3 renderPos = sat.position * (1.0f / 6371.0f);
-        
-        instanceData.push_back(renderPos.x);
-        instanceData.push_back(renderPos.y);
-        instanceData.push_back(renderPos.z);
-        instanceData.push_back(sat.color.r);
-        instanceData.push_back(sat.color.g);
-        instanceData.push_back(sat.color.b);
-        
-        // Beacon flash state (red light blinks)
-        // Each satellite blinks at different rate based on ID
-        float blinkSpeed = 2.0f + (sat.id % 10) * 0.3f; // Varied blink rates
-        float beaconState = (sin(time * blinkSpeed) > 0.0f) ? 1.0f : 0.0f;
-        instanceData.push_back(beaconState);
+void SatelliteSystem::syncKeplerInstances() {
+    const ElementsSoA& elements = satellites.elements;
+    size_t count = satellites.size();
+    
+    // Static part: only rebuilt when satellites were added
+    if(keplerInstanceCount != count) {
+        std::vector<KeplerInstance> instances(count);
+        for(size_t i = 0; i < count; ++i) {
+            KeplerInstance& k = instances[i];
+            k.orbit[0] = elements.semiMajorAxis[i];
+            k.orbit[1] = elements.eccentricity[i];
+            k.orbit[2] = elements.sqrtOneMinusE2[i];
+            k.orbit[3] = elements.meanMotion[i];
+            k.axisP[0] = elements.px[i]; k.axisP[1] = elements.py[i]; k.axisP[2] = elements.pz[i];
+            k.axisQ[0] = elements.qx[i]; k.axisQ[1] = elements.qy[i]; k.axisQ[2] = elements.qz[i];
+            const glm::vec3& color = satellites.colors[i];
+            k.color[0] = color.r; k.color[1] = color.g; k.color[2] = color.b;
+            k.id = satellites.ids[i];
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, keplerVBO);
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(KeplerInstance), instances.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        keplerInstanceCount = count;
+        phaseActiveCount = (size_t)-1; // Phases for the new slots too
     }
     
-    glBindBuffer(GL_ARRAY_BUFFER, satInstanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(float), instanceData.data(), GL_DYNAMIC_DRAW);
+    // Phase: follows the CPU rebase of the elements (hourly in sim time) and
+    // destroyed satellites, both rare
+    if(elements.epoch == phaseEpoch && satellites.activeCount() == phaseActiveCount) return;
+    
+    std::vector<float> phase(count * 2);
+    keplerVisibleCount = 0;
+    for(size_t i = 0; i < count; ++i) {
+        bool visible = satellites.active.test(i) && !satellites.sgp4[i];
+        phase[2 * i] = elements.meanAnomaly[i];
+        phase[2 * i + 1] = visible ? 1.0f : 0.0f;
+        if(visible) keplerVisibleCount++;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, keplerPhaseVBO);
+    glBufferData(GL_ARRAY_BUFFER, phase.size() * sizeof(float), phase.data(), GL_DYNAMIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    phaseEpoch = elements.epoch;
+    phaseActiveCount = satellites.activeCount();
 }
 
 void SatelliteSystem::initRenderData() {
@@ -306,7 +380,6 @@ void SatelliteSystem::initRenderData() {
     glGenVertexArrays(1, &satVAO);
     glGenBuffers(1, &satVBO);
     glGenBuffers(1, &satEBO);
-    glGenBuffers(1, &satInstanceVBO);
 
     glBindVertexArray(satVAO);
 
@@ -319,54 +392,134 @@ void SatelliteSystem::initRenderData() {
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, satInstanceVBO);
+    // Instance position, color and id (beacon blink rate) at locations 2-4;
+    // re-pointed at each upload's offset in update()
+    pointCpuInstances(0);
+    for(int location = 2; location <= 4; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+
+    glBindVertexArray(0);
+    
+    // Same mesh with the static orbit instances (GPU propagation)
+    glGenVertexArrays(1, &keplerVAO);
+    glGenBuffers(1, &keplerVBO);
+    glGenBuffers(1, &keplerPhaseVBO);
     
-    // Instance position (location = 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-    glVertexAttribDivisor(2, 1);
+    glBindVertexArray(keplerVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, satVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, satEBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     
-    // Instance color (location = 3)
+    glBindBuffer(GL_ARRAY_BUFFER, keplerVBO);
     glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(KeplerInstance), (void*)offsetof(KeplerInstance, color));
     glVertexAttribDivisor(3, 1);
-    
-    // Beacon state (location = 4)
     glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(6 * sizeof(float)));
+    glVertexAttribIPointer(4, 1, GL_INT, sizeof(KeplerInstance), (void*)offsetof(KeplerInstance, id));
     glVertexAttribDivisor(4, 1);
-
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(KeplerInstance), (void*)offsetof(KeplerInstance, orbit));
+    glVertexAttribDivisor(5, 1);
+    glEnableVertexAttribArray(6);
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(KeplerInstance), (void*)offsetof(KeplerInstance, axisP));
+    glVertexAttribDivisor(6, 1);
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 3, GL_FLOAT, GL_FALSE, sizeof(KeplerInstance), (void*)offsetof(KeplerInstance, axisQ));
+    glVertexAttribDivisor(7, 1);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, keplerPhaseVBO);
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glVertexAttribDivisor(8, 1);
+    
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
     
     indexCount = indices.size();
     
     glGenVertexArrays(1, &orbitVAO);
     glGenBuffers(1, &orbitVBO);
+    
+    // Procedural orbits: no vertex data, one instanced slot index per orbit
+    glGenVertexArrays(1, &ellipseVAO);
+    glGenBuffers(1, &ellipseTBO);
+    glGenTextures(1, &ellipseTexture);
+    
+    glBindVertexArray(ellipseVAO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glBindVertexArray(0);
 }
 
 void SatelliteSystem::initOrbits() {
-    std::vector<float> orbitData;
+    orbitSlotCount = satellites.size();
+    orbitDrawsDirty = true;
+    
+    // Ellipse axes of every slot (8 floats each), enough for the procedural mode
+    ElementsSoA orbitElements;
+    orbitElements.reserve(satellites.size());
+    for(size_t k = 0; k < satellites.size(); ++k) orbitElements.add(satellites.orbits[k], satellites.sgp4[k]);
+    
+    ellipseAxes.resize(satellites.size() * 2);
+    for(size_t k = 0; k < satellites.size(); ++k) {
+        float a = orbitElements.semiMajorAxis[k] * (1.0f / 6371.0f);
+        float b = a * orbitElements.sqrtOneMinusE2[k];
+        ellipseAxes[2 * k] = glm::vec4(orbitElements.px[k] * a, orbitElements.py[k] * a, orbitElements.pz[k] * a, orbitElements.eccentricity[k]);
+        ellipseAxes[2 * k + 1] = glm::vec4(orbitElements.qx[k] * b, orbitElements.qy[k] * b, orbitElements.qz[k] * b, 0.0f);
+    }
+    
+    glBindBuffer(GL_TEXTURE_BUFFER, ellipseTBO);
+    glBufferData(GL_TEXTURE_BUFFER, ellipseAxes.size() * sizeof(glm::vec4), ellipseAxes.data(), GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, ellipseTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, ellipseTBO);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
     
-    // Generate orbit path for each satellite
-    for(const auto& sat : satellites) {
-        int numPoints = 200;
-        float timeStep = (2.0f * 3.14159f) / numPoints * sqrt(sat.semiMajorAxis * sat.semiMajorAxis * sat.semiMajorAxis / 398600.4418f);
+    // Sampled paths are only built for the mode that draws them
+    orbitPointsPerOrbit = 0;
+    if(!proceduralOrbits) sampleOrbitPaths();
+}
+
+void SatelliteSystem::sampleOrbitPaths() {
+    const int numPoints = 200;
+    const size_t pointsPerOrbit = numPoints + 1;
+    
+    ElementsSoA orbitElements;
+    orbitElements.reserve(satellites.size());
+    std::vector<float> timeSteps(satellites.size());
+    for(size_t k = 0; k < satellites.size(); ++k) {
+        const OrbitElements& orbit = satellites.orbits[k];
+        orbitElements.add(orbit, satellites.sgp4[k]);
+        timeSteps[k] = (2.0f * 3.14159f) / numPoints * sqrt(orbit.semiMajorAxis * orbit.semiMajorAxis * orbit.semiMajorAxis / 398600.4418f);
+    }
+    
+    // Generate orbit path for every satellite at once: point i of each orbit is one batch
+    std::vector<float> orbitData(satellites.size() * pointsPerOrbit * 6);
+    std::vector<float> times(satellites.size());
+    StateSoA orbitState;
+    
+    for(int i = 0; i <= numPoints; ++i) {
+        for(size_t k = 0; k < satellites.size(); ++k) times[k] = i * timeSteps[k];
+        OrbitPropagator::PropagateBatch(orbitElements, times, orbitState);
         
-        for(int i = 0; i <= numPoints; ++i) {
-            float t = i * timeStep;
-            glm::vec3 pos = OrbitPropagator::CalculatePosition(sat, t);
-            glm::vec3 renderPos = pos * (1.0f / 6371.0f);
-            
-            orbitData.push_back(renderPos.x);
-            orbitData.push_back(renderPos.y);
-            orbitData.push_back(renderPos.z);
-            orbitData.push_back(sat.color.r * 0.4f); // Dimmer orbit lines
-            orbitData.push_back(sat.color.g * 0.4f);
-            orbitData.push_back(sat.color.b * 0.4f);
+        for(size_t k = 0; k < satellites.size(); ++k) {
+            glm::vec3 renderPos = orbitState.position(k) * (1.0f / 6371.0f);
+            float* v = &orbitData[(k * pointsPerOrbit + i) * 6];
+            v[0] = renderPos.x;
+            v[1] = renderPos.y;
+            v[2] = renderPos.z;
+            v[3] = satellites.colors[k].r * 0.4f; // Dimmer orbit lines
+            v[4] = satellites.colors[k].g * 0.4f;
+            v[5] = satellites.colors[k].b * 0.4f;
         }
     }
     
     orbitVertexCount = orbitData.size() / 6;
+    orbitPointsPerOrbit = (int)pointsPerOrbit;
+    orbitDrawsDirty = true;
     
     if(orbitVertexCount > 0) {
         glBindVertexArray(orbitVAO);
@@ -383,25 +536,35 @@ void SatelliteSystem::initOrbits() {
 }
 
 void SatelliteSystem::drawSatellites(const glm::mat4& view, const glm::mat4& projection) {
-    // Count active satellites for instanced drawing
-    int activeCount = 0;
-    for(const auto& s : satellites) {
-        if(s.active) activeCount++;
-    }
-    
-    if(activeCount == 0) return; // Don't draw if no active satellites
+    bool drawGpu = gpuPropagation && keplerVisibleCount > 0;
+    if(!drawGpu && cpuInstanceCount == 0) return; // Don't draw if no active satellites
     
     satShader->use();
     satShader->setMat4("view", view);
     satShader->setMat4("projection", projection);
-    // No uTime uniform needed for satellite shader
-    
-    glBindVertexArray(satVAO);
-    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, activeCount);
+    satShader->setFloat("uSimTime", (float)renderTime);
+    
+    if(drawGpu) {
+        // Every slot is instanced; destroyed ones are culled in the shader
+        satShader->setBool("uGpuKepler", true);
+        satShader->setFloat("uTime", (float)(renderTime - phaseEpoch));
+        glBindVertexArray(keplerVAO);
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, (GLsizei)keplerInstanceCount);
+    }
+    if(cpuInstanceCount > 0) {
+        satShader->setBool("uGpuKepler", false);
+        glBindVertexArray(satVAO);
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, cpuInstanceCount);
+    }
     glBindVertexArray(0);
 }
 
 void SatelliteSystem::drawOrbits(const glm::mat4& view, const glm::mat4& projection) {
+    if(proceduralOrbits) {
+        drawOrbitEllipses(view, projection);
+        return;
+    }
+    if(orbitPointsPerOrbit == 0 && orbitSlotCount > 0) sampleOrbitPaths(); // Switched from procedural
     if(orbitVertexCount == 0) return;
     
     orbitShader->use();
@@ -409,15 +572,78 @@ void SatelliteSystem::drawOrbits(const glm::mat4& view, const glm::mat4& project
     orbitShader->setMat4("projection", projection);
     orbitShader->setMat4("model", glm::mat4(1.0f));
     
-    glBindVertexArray(orbitVAO);
+    if(orbitDrawsDirty) rebuildOrbitDraws();
+    if(orbitFirsts.empty()) return;
     
-    // Draw each orbit as a line loop
-    int pointsPerOrbit = 201; // 200 segments + 1 to close
-    for(size_t i = 0; i < satellites.size(); ++i) {
-        // Optimization: Could skip inactive orbits here, but orbitVBO is static
-        // So we draw all orbit lines even for destroyed satellites (as trails)
-        glDrawArrays(GL_LINE_STRIP, i * pointsPerOrbit, pointsPerOrbit);
+    // Every active orbit's strip in one call
+    glBindVertexArray(orbitVAO);
+    glMultiDrawArrays(GL_LINE_STRIP, orbitFirsts.data(), orbitCounts.data(), (GLsizei)orbitFirsts.size());
+    glBindVertexArray(0);
+}
+
+void SatelliteSystem::rebuildOrbitDraws() {
+    // Destroyed satellites drop their orbit line
+    orbitFirsts.clear();
+    orbitCounts.clear();
+    satellites.active.forEach([&](size_t i) {
+        if(i >= orbitSlotCount) return; // Added after initOrbits, no path
+        orbitFirsts.push_back((GLint)(i * orbitPointsPerOrbit));
+        orbitCounts.push_back(orbitPointsPerOrbit);
+    });
+    orbitDrawsDirty = false;
+}
+
+void SatelliteSystem::drawOrbitEllipses(const glm::mat4& view, const glm::mat4& projection) {
+    if(orbitSlotCount == 0) return;
+    
+    // Screen-space detail: projected radius of each orbit (pixels) from the
+    // depth of its nearest point, rounded up to a power-of-two segment count
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float pixelsPerUnit = projection[1][1] * 0.5f * viewport[3];
+    
+    std::vector<int32_t> levels[ORBIT_LOD_LEVELS];
+    satellites.active.forEach([&](size_t i) {
+        if(i >= orbitSlotCount) return;
+        const glm::vec4& axisA = ellipseAxes[2 * i];
+        glm::vec3 major(axisA.x, axisA.y, axisA.z);
+        float a = glm::length(major);
+        glm::vec3 center = major * -axisA.w;
+        float depth = -(view * glm::vec4(center, 1.0f)).z;
+        float nearest = std::max(depth - a, 0.05f * a); // Camera inside the orbit: treat as close
+        float circumference = 6.2831853f * a / nearest * pixelsPerUnit;
+        
+        int level = 0;
+        while(level < ORBIT_LOD_LEVELS - 1 && (ORBIT_MIN_SEGMENTS << level) * ORBIT_PIXELS_PER_SEGMENT < circumference) level++;
+        levels[level].push_back((int32_t)i);
+    });
+    
+    ellipseSlots.clear();
+    for(const auto& level : levels) ellipseSlots.insert(ellipseSlots.end(), level.begin(), level.end());
+    if(ellipseSlots.empty()) return;
+    GLintptr offset = ellipseSlotStream.upload(ellipseSlots.data(), ellipseSlots.size() * sizeof(int32_t));
+    
+    ellipseShader->use();
+    ellipseShader->setMat4("view", view);
+    ellipseShader->setMat4("projection", projection);
+    ellipseShader->setInt("uEllipses", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, ellipseTexture);
+    
+    // One instanced strip per detail level, each instance one orbit
+    glBindVertexArray(ellipseVAO);
+    ellipseSlotStream.bind();
+    size_t first = 0;
+    for(int level = 0; level < ORBIT_LOD_LEVELS; ++level) {
+        size_t count = levels[level].size();
+        if(count == 0) continue;
+        int segments = ORBIT_MIN_SEGMENTS << level;
+        ellipseShader->setInt("uSegments", segments);
+        glVertexAttribIPointer(0, 1, GL_INT, sizeof(int32_t), (void*)(offset + first * sizeof(int32_t)));
+        glDrawArraysInstanced(GL_LINE_STRIP, 0, segments + 1, (GLsizei)count);
+        first += count;
     }
-    
+    ellipseSlotStream.unbind();
     glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
 }
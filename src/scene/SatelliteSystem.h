@@ -1,53 +1,89 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 #include "../render/Shader.h"
 #include "../render/Buffers.h"
+#include "../sim/SatelliteCatalog.h"
 
-struct Satellite {
-    int id;
-    std::string name;
-    // Keplerian Elements
-    float semiMajorAxis; // km
-    float eccentricity;
-    float inclination; // radians
-    float raan; // radians
-    float argPeriapsis; // radians
-    float meanAnomaly; // radians at epoch
-    
-    // Calculated state
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec3 color;
-    
-    bool active = true; // For destroying satellites
-};
-
-class SatelliteSystem {
+// Rendering front-end for the satellite catalog (instanced models + orbit lines).
+//
+// By default two-body satellites are propagated for display in satellite.vert:
+// their elements sit in a static instance buffer and the shader solves Kepler
+// from the uTime uniform, so drawing them costs no per-frame upload. Only
+// SGP4 objects (whose perturbations the shader does not model) go through the
+// CPU path, which streams positions propagated by update(). The CPU still
+// propagates every satellite each update for collision checks.
+//
+// Orbit lines are likewise generated in orbit_procedural.vert from two axis
+// vectors per orbit, with a segment count picked per frame from each orbit's
+// size on screen. The sampled mode keeps a precomputed 201-point path per
+// orbit in a static VBO.
+class SatelliteSystem : public SatelliteCatalog {
 public:
     SatelliteSystem();
     ~SatelliteSystem();
     
-    void addSatellite(const Satellite& sat);
-    void initOrbits(); // Generate orbit paths
+    void initOrbits(); // Set up orbit lines for the current catalog
     
-    void update(float time);
+    void update(SimTime time);
     void drawSatellites(const glm::mat4& view, const glm::mat4& projection);
     void drawOrbits(const glm::mat4& view, const glm::mat4& projection);
     
-    void destroySatellite(int id); // Mark as inactive
+    // Off: every satellite through the CPU path (reference for comparing renders)
+    void setGpuPropagation(bool enabled) { gpuPropagation = enabled; }
+    bool getGpuPropagation() const { return gpuPropagation; }
     
-    const std::vector<Satellite>& getSatellites() const { return satellites; }
+    // Off: orbits drawn from paths sampled on the CPU by initOrbits
+    void setProceduralOrbits(bool enabled) { proceduralOrbits = enabled; }
+    bool getProceduralOrbits() const { return proceduralOrbits; }
     
 private:
-    std::vector<Satellite> satellites;
     Shader* satShader;
     Shader* orbitShader;
+    Shader* ellipseShader;
     
-    unsigned int satVAO, satVBO, satEBO, satInstanceVBO;
+    unsigned int satVAO, satVBO, satEBO;
+    StreamBuffer instanceStream; // CPU path instances, rewritten every update
     unsigned int orbitVAO, orbitVBO;
     int orbitVertexCount = 0;
+    int orbitPointsPerOrbit = 0;
+    size_t orbitSlotCount = 0; // Slots set up by initOrbits
+    
+    // glMultiDrawArrays ranges of the active orbits, rebuilt after a destroy
+    std::vector<GLint> orbitFirsts;
+    std::vector<GLsizei> orbitCounts;
+    bool orbitDrawsDirty = true;
+    
+    // Procedural orbits: per-slot ellipse axes (CPU copy for the LOD pick,
+    // texture buffer for the shader) and the per-frame slot lists, one
+    // contiguous run per segment count
+    bool proceduralOrbits = true;
+    unsigned int ellipseVAO, ellipseTBO, ellipseTexture;
+    std::vector<glm::vec4> ellipseAxes; // A = a * P (w = e), B = b * Q per slot
+    std::vector<int32_t> ellipseSlots;
+    StreamBuffer ellipseSlotStream;
+    
     int indexCount = 0;
+    int cpuInstanceCount = 0; // Instances in the last instanceStream upload
+    SimTime renderTime = 0.0; // Sim time of the last update()
+    
+    // GPU propagation: one static entry per catalog slot, plus the mean anomaly
+    // and visibility, re-uploaded only when the elements are rebased or a
+    // satellite is destroyed
+    bool gpuPropagation = true;
+    unsigned int keplerVAO, keplerVBO, keplerPhaseVBO;
+    size_t keplerInstanceCount = 0;
+    size_t keplerVisibleCount = 0;
+    SimTime phaseEpoch = 0.0;
+    size_t phaseActiveCount = 0;
     
     void initRenderData();
+    void syncKeplerInstances();
+    void pointCpuInstances(GLintptr offset);
+    void sampleOrbitPaths();
+    void rebuildOrbitDraws();
+    void drawOrbitEllipses(const glm::mat4& view, const glm::mat4& projection);
+    void onSatelliteDestroyed(size_t /*slot*/) override { orbitDrawsDirty = true; }
+    bool drawsOnGpu(size_t slot) const { return gpuPropagation && !satellites.sgp4[slot]; }
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bit per catalog slot, set while the satellite is active. Loops over the
+// live satellites walk 64 slots per word and skip destroyed runs entirely
+// instead of loading a bool from every record.
+class ActiveMask {
+public:
+    void clear() {
+        words.clear();
+        bits = 0;
+        setCount = 0;
+    }
+    
+    void reserve(size_t count) { words.reserve((count + 63) / 64); }
+    
+    void push(bool on) {
+        if(bits % 64 == 0) words.push_back(0);
+        bits++;
+        set(bits - 1, on);
+    }
+    
+    void set(size_t i, bool on) {
+        uint64_t bit = uint64_t(1) << (i % 64);
+        uint64_t& word = words[i / 64];
+        if(((word & bit) != 0) == on) return;
+        word ^= bit;
+        if(on) setCount++;
+        else setCount--;
+    }
+    
+    bool test(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    
+    size_t size() const { return bits; }
+    size_t count() const { return setCount; } // Active slots
+    
+    // Calls f(index) for every set bit, in increasing index order
+    template<typename F>
+    void forEach(F&& f) const {
+        for(size_t w = 0; w < words.size(); ++w) {
+            uint64_t word = words[w];
+            while(word) {
+                f(w * 64 + (size_t)std::countr_zero(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words;
+    size_t bits = 0;
+    size_t setCount = 0;
+};
@@ -1,12 +1,15 @@
 #pragma once
 #include <vector>
 #include <glm/glm.hpp>
-#include "../scene/SatelliteSystem.h"
+#include "../scene/Satellite.h"
+#include "SatelliteStore.h"
+#include "SpatialHash.h"
+#include "SimTime.h"
 
 struct CollisionEvent {
     int sat1_id;
     int sat2_id;
-    float time;
+    SimTime time;
     glm::vec3 collisionPoint;
     glm::vec3 impactPointOnEarth;
     float timeToImpact;
@@ -24,14 +27,31 @@ struct CollisionPrediction {
 
 class ConjunctionManager {
 public:
-    void update(const std::vector<Satellite>& satellites, float time);
+    ConjunctionManager();
+    
+    void update(const SatelliteStore& satellites, SimTime time);
     const std::vector<CollisionEvent>& getEvents() const { return events; }
     const std::vector<CollisionPrediction>& getPredictions() const { return predictions; }
     
+    void setThreshold(float km) { threshold = km; }
+    float getThreshold() const { return threshold; }
+    
 private:
     std::vector<CollisionEvent> events;
     std::vector<CollisionPrediction> predictions;
     
-    void predictTrajectory(const Satellite& sat, float currentTime);
+    float threshold; // km
+    
+    // Broad phase (grid cell size == threshold), buffers reused across frames
+    struct PairHit {
+        int i;
+        int j;
+        float distance;
+    };
+    SpatialHash grid;
+    std::vector<std::pair<int,int>> candidatePairs;
+    std::vector<PairHit> hits;
+    
+    void predictTrajectory(const Satellite& sat, SimTime currentTime);
     glm::vec3 calculateImpactPoint(const glm::vec3& position, const glm::vec3& velocity);
 };
@@ -15,18 +15,16 @@ ConjunctionVisualizer::ConjunctionVisualizer()
     corridorShader = new Shader("shaders/warning.vert", "shaders/warning.frag");
     
     glGenVertexArrays(1, &tcaVAO);
-    glGenBuffers(1, &tcaVBO);
     glGenVertexArrays(1, &corridorVAO);
-    glGenBuffers(1, &corridorVBO);
 }
 
 ConjunctionVisualizer::~ConjunctionVisualizer() {
     delete markerShader;
     delete corridorShader;
     glDeleteVertexArrays(1, &tcaVAO);
-    glDeleteBuffers(1, &tcaVBO);
+    tcaStream.remove();
     glDeleteVertexArrays(1, &corridorVAO);
-    glDeleteBuffers(1, &corridorVBO);
+    corridorStream.remove();
 }
 
 glm::vec3 ConjunctionVisualizer::getRiskColor(RiskLevel level) {
@@ -59,14 +57,14 @@ void ConjunctionVisualizer::update(const std::vector<ConjunctionEvent>& events,
     // Upload TCA marker data
     tcaVertexCount = tcaMarkerData.size() / 6;
     if(tcaVertexCount > 0) {
+        GLintptr offset = tcaStream.upload(tcaMarkerData.data(), tcaMarkerData.size() * sizeof(float));
         glBindVertexArray(tcaVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, tcaVBO);
-        glBufferData(GL_ARRAY_BUFFER, tcaMarkerData.size() * sizeof(float), tcaMarkerData.data(), GL_DYNAMIC_DRAW);
+        tcaStream.bind();
         
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)offset);
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(offset + 3 * sizeof(float)));
         
         glBindVertexArray(0);
     }
@@ -74,14 +72,14 @@ void ConjunctionVisualizer::update(const std::vector<ConjunctionEvent>& events,
     // Upload corridor data
     corridorVertexCount = corridorData.size() / 6;
     if(corridorVertexCount > 0) {
+        GLintptr offset = corridorStream.upload(corridorData.data(), corridorData.size() * sizeof(float));
         glBindVertexArray(corridorVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, corridorVBO);
-        glBufferData(GL_ARRAY_BUFFER, corridorData.size() * sizeof(float), corridorData.data(), GL_DYNAMIC_DRAW);
+        corridorStream.bind();
         
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)offset);
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(offset + 3 * sizeof(float)));
         
         glBindVertexArray(0);
     }
@@ -2,6 +2,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "../render/Shader.h"
+#include "../render/Buffers.h"
 #include "conjunctions/ConjunctionAnalyzer.h"
 
 class ConjunctionVisualizer {
@@ -20,8 +21,8 @@ private:
     Shader* markerShader;
     Shader* corridorShader;
     
-    unsigned int tcaVAO, tcaVBO;
-    unsigned int corridorVAO, corridorVBO;
+    unsigned int tcaVAO, corridorVAO;
+    StreamBuffer tcaStream, corridorStream;
     
     std::vector<float> tcaMarkerData;
     std::vector<float> corridorData;
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Dense open-addressing map from satellite id to slot (index into the
+// catalog's vector). Entries are never removed: destroyed satellites keep
+// their slot, so the table only grows and needs no tombstones. Linear
+// probing over a flat array keeps a lookup to one or two cache lines.
+class IdIndex {
+public:
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+    void clear() {
+        table.clear();
+        count = 0;
+    }
+
+    void reserve(size_t entries) {
+        if(entries * 2 > table.size()) rehash(entries * 2);
+    }
+
+    // Keeps the existing slot if id is already present (first entry wins,
+    // as with the linear scans this replaces). Returns false in that case.
+    bool insert(int id, uint32_t slot) {
+        if((count + 1) * 2 > table.size()) rehash(table.empty() ? 64 : table.size() * 2);
+        size_t mask = table.size() - 1;
+        for(size_t i = hash(id) & mask; ; i = (i + 1) & mask) {
+            Entry& e = table[i];
+            if(e.slot == NOT_FOUND) {
+                e.id = id;
+                e.slot = slot;
+                count++;
+                return true;
+            }
+            if(e.id == id) return false;
+        }
+    }
+
+    uint32_t find(int id) const {
+        if(table.empty()) return NOT_FOUND;
+        size_t mask = table.size() - 1;
+        for(size_t i = hash(id) & mask; ; i = (i + 1) & mask) {
+            const Entry& e = table[i];
+            if(e.slot == NOT_FOUND) return NOT_FOUND;
+            if(e.id == id) return e.slot;
+        }
+    }
+
+    size_t size() const { return count; }
+
+private:
+    struct Entry {
+        int32_t id = 0;
+        uint32_t slot = NOT_FOUND; // NOT_FOUND marks an empty bucket
+    };
+
+    std::vector<Entry> table; // Power-of-two size, at most half full
+    size_t count = 0;
+
+    // Catalog ids are often sequential; the multiplicative hash spreads them
+    static size_t hash(int id) {
+        return (size_t)(((uint64_t)(uint32_t)id * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    void rehash(size_t minBuckets) {
+        size_t n = 64;
+        while(n < minBuckets) n <<= 1;
+        std::vector<Entry> old;
+        old.swap(table);
+        table.resize(n);
+        count = 0;
+        for(const Entry& e : old) {
+            if(e.slot != NOT_FOUND) insert(e.id, e.slot);
+        }
+    }
+};
@@ -1,116 +1,117 @@
 #include "OrbitPropagator.h"
+#include "Sgp4Propagator.h"
 #include <cmath>
 
-const float MU = 398600.4418f; // Earth gravitational parameter km^3/s^2
+const double MU = 398600.4418; // Earth gravitational parameter km^3/s^2
 
-void OrbitPropagator::Propagate(Satellite& sat, float time) {
-    sat.position = CalculatePosition(sat, time);
-    sat.velocity = CalculateVelocity(sat, time);
+namespace {
+const double TWO_PI = 6.283185307179586;
+const int KEPLER_MAX_ITERATIONS = 20;
+
+template<typename Real> Real KeplerTolerance();
+template<> float KeplerTolerance<float>() { return 1e-6f; }    // rad
+template<> double KeplerTolerance<double>() { return 1e-12; }
 }
 
-glm::vec3 OrbitPropagator::CalculatePosition(const Satellite& sat, float time) {
-    // Mean Motion
-    float a = sat.semiMajorAxis;
-    float n = sqrt(MU / (a * a * a));
-    
-    // Mean Anomaly at time t
-    float M = sat.meanAnomaly + n * time;
-    
-    // Solve Kepler's Equation for Eccentric Anomaly E: M = E - e*sin(E)
-    float E = M;
-    for(int i=0; i<10; ++i) {
-        E = M + sat.eccentricity * sin(E);
+bool OrbitPropagator::Propagate(Satellite& sat, SimTime time) {
+    return CalculateState(sat, time, sat.position, sat.velocity);
+}
+
+glm::vec3 OrbitPropagator::CalculatePosition(const Satellite& sat, SimTime time) {
+    glm::vec3 position(0.0f), velocity(0.0f);
+    CalculateState(sat, time, position, velocity);
+    return position;
+}
+
+glm::vec3 OrbitPropagator::CalculateVelocity(const Satellite& sat, SimTime time) {
+    glm::vec3 position(0.0f), velocity(0.0f);
+    CalculateState(sat, time, position, velocity);
+    return velocity;
+}
+
+template<typename Real>
+Real OrbitPropagator::SolveKepler(Real M, Real e) {
+    // Wrap M to [-pi, pi) so the starter is in range
+    M -= Real(TWO_PI) * std::floor(M / Real(TWO_PI) + Real(0.5));
+    
+    // Danby's starter, then Newton-Raphson on f(E) = E - e*sin(E) - M.
+    // Converges in a handful of steps even for e close to 1.
+    Real E = M + (M >= Real(0) ? Real(0.85) : Real(-0.85)) * e;
+    for(int k = 0; k < KEPLER_MAX_ITERATIONS; ++k) {
+        Real dE = (E - e * std::sin(E) - M) / (Real(1) - e * std::cos(E));
+        E -= dE;
+        if(std::fabs(dE) < KeplerTolerance<Real>()) break;
     }
-    
-    // True Anomaly v
-    float v = 2 * atan(sqrt((1 + sat.eccentricity)/(1 - sat.eccentricity)) * tan(E/2));
-    
-    // Distance r
-    float r = a * (1 - sat.eccentricity * cos(E));
-    
-    // Position in orbital plane
-    float x_orb = r * cos(v);
-    float y_orb = r * sin(v);
-    
-    // Rotate to ECI
-    float O = sat.raan;
-    float w = sat.argPeriapsis;
-    float i = sat.inclination;
-    
-    float x = x_orb * (cos(O)*cos(w) - sin(O)*sin(w)*cos(i)) - y_orb * (cos(O)*sin(w) + sin(O)*cos(w)*cos(i));
-    float y = x_orb * (sin(O)*cos(w) + cos(O)*sin(w)*cos(i)) - y_orb * (sin(O)*sin(w) - cos(O)*cos(w)*cos(i)); // Z-up?
-    // Wait, standard conversion gives Z as axis of rotation for RAAN?
-    // Standard ECI: Z is North.
-    // x = ...
-    // y = ...
-    // z = ...
-    
-    // Let's use standard formulas for Z-up
-    // X = r ( cos(O) cos(w+v) - sin(O) sin(w+v) cos(i) )
-    // Y = r ( sin(O) cos(w+v) + cos(O) sin(w+v) cos(i) )
-    // Z = r ( sin(w+v) sin(i) )
-    
-    float u = w + v; // Argument of latitude
-    float X = r * (cos(O)*cos(u) - sin(O)*sin(u)*cos(i));
-    float Y = r * (sin(O)*cos(u) + cos(O)*sin(u)*cos(i)); // This is Y in ECI (equatorial plane)
-    float Z = r * (sin(u)*sin(i)); // This is Z (North)
-    
-    // BUT our OpenGL world is usually Y-up.
-    // So we map ECI (X, Y, Z) -> OpenGL (X, Z, -Y)? Or (X, Y, Z) if we rotated Earth?
-    // My Earth has poles on local Y.
-    // So I should map ECI Z -> OpenGL Y.
-    // ECI X -> OpenGL X
-    // ECI Y -> OpenGL Z
-    
-    return glm::vec3(X, Z, Y); // Swap Y and Z to match Y-up world
+    return E;
 }
 
-glm::vec3 OrbitPropagator::CalculateVelocity(const Satellite& sat, float time) {
-    // Calculate velocity using orbital mechanics
-    // v = sqrt(μ * (2/r - 1/a))
-    
-    float a = sat.semiMajorAxis;
-    float n = sqrt(MU / (a * a * a));
-    float M = sat.meanAnomaly + n * time;
-    
-    // Solve for E
-    float E = M;
-    for(int i=0; i<10; ++i) {
-        E = M + sat.eccentricity * sin(E);
+template<typename Real>
+bool OrbitPropagator::CalculateState(const Satellite& sat, SimTime time,
+                                     glm::vec<3, Real>& position, glm::vec<3, Real>& velocity) {
+    return CalculateState(sat.elements(), sat.sgp4.get(), time, position, velocity);
+}
+
+template<typename Real>
+bool OrbitPropagator::CalculateState(const OrbitElements& orbit, const Sgp4Record* sgp4, SimTime time,
+                                     glm::vec<3, Real>& position, glm::vec<3, Real>& velocity) {
+    if(sgp4) {
+        double r[3], v[3];
+        // Decayed or invalid at this time: no state, the two-body elements are
+        // only SGP4's mean elements and would put the object somewhere else
+        if(Sgp4Propagator::Propagate(*sgp4, time, r, v) != Sgp4Propagator::OK) return false;
+        
+        // TEME (X, Y, Z) -> OpenGL (X, Z, Y)
+        position = glm::vec<3, Real>((Real)r[0], (Real)r[2], (Real)r[1]);
+        velocity = glm::vec<3, Real>((Real)v[0], (Real)v[2], (Real)v[1]);
+        return true;
     }
     
-    float v = 2 * atan(sqrt((1 + sat.eccentricity)/(1 - sat.eccentricity)) * tan(E/2));
-    float r = a * (1 - sat.eccentricity * cos(E));
-    
-    // Velocity magnitude
-    float speed = sqrt(MU * (2.0f/r - 1.0f/a));
-    
-    // Velocity direction in orbital plane (perpendicular to position)
-    // In the orbital plane, velocity is tangent to the orbit
-    float vx_orb = -sin(v) * speed / sqrt(1.0f); // Simplified
-    float vy_orb = (sat.eccentricity + cos(v)) * speed / sqrt(1.0f + 2.0f*sat.eccentricity*cos(v) + sat.eccentricity*sat.eccentricity);
-    
-    // More accurate: use specific angular momentum
-    float h = sqrt(MU * a * (1 - sat.eccentricity * sat.eccentricity));
-    vx_orb = -(MU / h) * sin(v);
-    vy_orb = (MU / h) * (sat.eccentricity + cos(v));
-    
-    // Rotate to ECI
-    float O = sat.raan;
-    float w = sat.argPeriapsis;
-    float i = sat.inclination;
-    
-    float cos_w = cos(w);
-    float sin_w = sin(w);
-    float cos_O = cos(O);
-    float sin_O = sin(O);
-    float cos_i = cos(i);
-    float sin_i = sin(i);
-    
-    float vx = vx_orb * (cos_O*cos_w - sin_O*sin_w*cos_i) - vy_orb * (cos_O*sin_w + sin_O*cos_w*cos_i);
-    float vy = vx_orb * (sin_O*cos_w + cos_O*sin_w*cos_i) - vy_orb * (sin_O*sin_w - cos_O*cos_w*cos_i);
-    float vz = vx_orb * (sin_w*sin_i) + vy_orb * (cos_w*sin_i);
-    
-    // Map to OpenGL coordinates (ECI Z -> OpenGL Y)
-    return glm::vec3(vx, vz, vy);
+    Real a = orbit.semiMajorAxis;
+    Real e = orbit.eccentricity;
+    
+    // Mean anomaly at time t, advanced and wrapped in double: n * t grows without
+    // bound and would lose the fractional turn in float after a few days
+    double n = std::sqrt(MU / ((double)a * a * a));
+    double M = orbit.meanAnomaly + n * time;
+    M -= TWO_PI * std::floor(M / TWO_PI);
+    
+    // Eccentric anomaly, solved once for both vectors
+    Real E = SolveKepler<Real>((Real)M, e);
+    Real cosE = std::cos(E);
+    Real sinE = std::sin(E);
+    
+    // Position and velocity in the perifocal frame straight from E,
+    // no true anomaly needed
+    Real b = std::sqrt(Real(1) - e * e);
+    Real r = a * (Real(1) - e * cosE);
+    Real x_orb = a * (cosE - e);
+    Real y_orb = a * b * sinE;
+    Real vfac = std::sqrt(Real(MU) * a) / r;
+    Real vx_orb = -vfac * sinE;
+    Real vy_orb = vfac * b * cosE;
+    
+    // Perifocal -> ECI rotation (Z north)
+    Real O = orbit.raan, w = orbit.argPeriapsis, i = orbit.inclination;
+    Real cos_O = std::cos(O), sin_O = std::sin(O);
+    Real cos_w = std::cos(w), sin_w = std::sin(w);
+    Real cos_i = std::cos(i), sin_i = std::sin(i);
+    
+    glm::vec<3, Real> P(cos_O*cos_w - sin_O*sin_w*cos_i, sin_O*cos_w + cos_O*sin_w*cos_i, sin_w*sin_i);
+    glm::vec<3, Real> Q(-(cos_O*sin_w + sin_O*cos_w*cos_i), -(sin_O*sin_w - cos_O*cos_w*cos_i), cos_w*sin_i);
+    
+    glm::vec<3, Real> pos = x_orb * P + y_orb * Q;
+    glm::vec<3, Real> vel = vx_orb * P + vy_orb * Q;
+    
+    // Our OpenGL world is Y-up with Earth's poles on local Y,
+    // so map ECI (X, Y, Z) -> OpenGL (X, Z, Y)
+    position = glm::vec<3, Real>(pos.x, pos.z, pos.y);
+    velocity = glm::vec<3, Real>(vel.x, vel.z, vel.y);
+    return true;
 }
+
+template float OrbitPropagator::SolveKepler<float>(float, float);
+template double OrbitPropagator::SolveKepler<double>(double, double);
+template bool OrbitPropagator::CalculateState<float>(const Satellite&, SimTime, glm::vec3&, glm::vec3&);
+template bool OrbitPropagator::CalculateState<double>(const Satellite&, SimTime, glm::dvec3&, glm::dvec3&);
+template bool OrbitPropagator::CalculateState<float>(const OrbitElements&, const Sgp4Record*, SimTime, glm::vec3&, glm::vec3&);
+template bool OrbitPropagator::CalculateState<double>(const OrbitElements&, const Sgp4Record*, SimTime, glm::dvec3&, glm::dvec3&);
@@ -1,9 +1,84 @@
 #pragma once
-#include "../scene/SatelliteSystem.h"
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include "../scene/Satellite.h"
+#include "SimTime.h"
+#include "../util/AlignedAllocator.h"
+
+// Orbital elements of many satellites in structure-of-arrays form, with the
+// per-orbit constants (mean motion, perifocal axes) precomputed once.
+// The float kernel works on time relative to `epoch`; rebase() moves the
+// epoch (in double precision) so that offset stays small on long runs.
+// Arrays are cache-line aligned for the vector kernels.
+struct ElementsSoA {
+    AlignedVector<float> semiMajorAxis;  // km
+    AlignedVector<float> eccentricity;
+    AlignedVector<float> meanMotion;     // rad/s
+    AlignedVector<float> meanAnomaly;    // M at epoch, wrapped to [0, 2pi) (rad)
+    AlignedVector<float> meanAnomalyAtZero; // M at sim time 0 (rad)
+    AlignedVector<float> sqrtOneMinusE2; // sqrt(1 - e^2)
+    AlignedVector<float> px, py, pz;     // Perifocal P axis (towards periapsis), render frame
+    AlignedVector<float> qx, qy, qz;     // Perifocal Q axis, render frame
+    SimTime epoch = 0.0;
+    
+    // SGP4 objects: the kernel output at these indices is replaced by SGP4
+    std::vector<size_t> sgp4Index;
+    std::vector<std::shared_ptr<const Sgp4Record>> sgp4Records;
+    
+    size_t size() const { return semiMajorAxis.size(); }
+    void clear();
+    void reserve(size_t count);
+    void add(const Satellite& sat);
+    void add(const OrbitElements& orbit, const std::shared_ptr<const Sgp4Record>& sgp4);
+    void rebase(SimTime newEpoch);
+};
+
+// Propagated positions (km) and velocities (km/s) matching an ElementsSoA
+struct StateSoA {
+    AlignedVector<float> x, y, z;
+    AlignedVector<float> vx, vy, vz;
+    
+    size_t size() const { return x.size(); }
+    void resize(size_t count);
+    void reserve(size_t count);
+    glm::vec3 position(size_t i) const { return glm::vec3(x[i], y[i], z[i]); }
+    glm::vec3 velocity(size_t i) const { return glm::vec3(vx[i], vy[i], vz[i]); }
+};
 
 class OrbitPropagator {
 public:
-    static void Propagate(Satellite& sat, float time);
-    static glm::vec3 CalculatePosition(const Satellite& sat, float time);
-    static glm::vec3 CalculateVelocity(const Satellite& sat, float time);
+    // False when SGP4 fails (decayed or invalid elements at this time); the
+    // state is then left untouched rather than taken from the two-body model
+    static bool Propagate(Satellite& sat, SimTime time);
+    static glm::vec3 CalculatePosition(const Satellite& sat, SimTime time);
+    static glm::vec3 CalculateVelocity(const Satellite& sat, SimTime time);
+    
+    // Position (km) and velocity (km/s) from a single Kepler solve. The mean
+    // anomaly is always advanced in double; Real sets the precision of the
+    // rest (float for bulk work, double for TCA refinement).
+    template<typename Real>
+    static bool CalculateState(const Satellite& sat, SimTime time,
+                               glm::vec<3, Real>& position, glm::vec<3, Real>& velocity);
+    template<typename Real>
+    static bool CalculateState(const OrbitElements& orbit, const Sgp4Record* sgp4, SimTime time,
+                               glm::vec<3, Real>& position, glm::vec<3, Real>& velocity);
+    
+    // Eccentric anomaly for mean anomaly M (Newton-Raphson to 1e-6 rad in
+    // float, 1e-12 rad in double)
+    template<typename Real>
+    static Real SolveKepler(Real M, Real e);
+    
+    // Batch propagation of every element set to one time (or one time per
+    // object, given relative to elements.epoch). Uses AVX-512 (16 lanes) or
+    // AVX2 (8 lanes) when the CPU supports it, otherwise a scalar loop
+    // running the same kernel. Float precision: keep time within a few
+    // hours of elements.epoch. SGP4 objects are evaluated after the kernel;
+    // one that SGP4 cannot propagate (decayed) gets a NaN state and its index
+    // is appended to failed, if given.
+    static void PropagateBatch(const ElementsSoA& elements, SimTime time, StateSoA& state,
+                               std::vector<size_t>* failed = nullptr);
+    static void PropagateBatch(const ElementsSoA& elements, const std::vector<float>& times, StateSoA& state);
+    
+    static const char* BatchIsaName(); // "avx512", "avx2" or "scalar"
 };
@@ -0,0 +1,176 @@
+#include "OrbitPropagator.h"
+#include "Sgp4Propagator.h"
+#include "simd/KeplerKernel.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+// Scalar instantiation of the kernel, used when no vector ISA is available
+struct ScalarOps {
+    using Vec = float;
+    static const size_t WIDTH = 1;
+    
+    static Vec set(float v) { return v; }
+    static Vec sqrt(Vec v) { return std::sqrt(v); }
+    static Vec round(Vec v) { return std::nearbyint(v); }
+    static Vec floor(Vec v) { return std::floor(v); }
+    static Vec selectGreater(Vec a, Vec b, Vec x, Vec y) { return a > b ? x : y; }
+    static Vec load(const float* p, size_t) { return *p; }
+    static void store(float* p, Vec v, size_t) { *p = v; }
+};
+
+void KeplerBatchScalar(const KeplerBatchArgs& args) {
+    KeplerBatch<ScalarOps>(args);
+}
+
+typedef void (*KeplerBatchFn)(const KeplerBatchArgs&);
+
+struct BatchBackend {
+    KeplerBatchFn fn;
+    const char* name;
+};
+
+BatchBackend SelectBackend() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#ifdef SATSIM_HAVE_AVX512
+    if(__builtin_cpu_supports("avx512f")) return {KeplerBatchAvx512, "avx512"};
+#endif
+#ifdef SATSIM_HAVE_AVX2
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return {KeplerBatchAvx2, "avx2"};
+#endif
+#endif
+    return {KeplerBatchScalar, "scalar"};
+}
+
+const BatchBackend& Backend() {
+    static const BatchBackend backend = SelectBackend(); // Chosen once at first use
+    return backend;
+}
+
+void RunBatch(const ElementsSoA& elements, const float* times, SimTime time, StateSoA& state,
+              std::vector<size_t>* failed) {
+    state.resize(elements.size());
+    
+    KeplerBatchArgs args;
+    args.count = elements.size();
+    args.semiMajorAxis = elements.semiMajorAxis.data();
+    args.eccentricity = elements.eccentricity.data();
+    args.meanMotion = elements.meanMotion.data();
+    args.meanAnomaly = elements.meanAnomaly.data();
+    args.sqrtOneMinusE2 = elements.sqrtOneMinusE2.data();
+    args.px = elements.px.data(); args.py = elements.py.data(); args.pz = elements.pz.data();
+    args.qx = elements.qx.data(); args.qy = elements.qy.data(); args.qz = elements.qz.data();
+    args.times = times;
+    args.time = (float)(time - elements.epoch);
+    args.x = state.x.data(); args.y = state.y.data(); args.z = state.z.data();
+    args.vx = state.vx.data(); args.vy = state.vy.data(); args.vz = state.vz.data();
+    
+    Backend().fn(args);
+    
+    // Overwrite the two-body approximation of TLE objects. On an SGP4 error
+    // (e.g. decayed) the object has no valid state: it gets NaN rather than a
+    // two-body position from a different model, and is reported to the caller
+    const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+    for(size_t k = 0; k < elements.sgp4Index.size(); ++k) {
+        size_t i = elements.sgp4Index[k];
+        SimTime t = times ? elements.epoch + times[i] : time;
+        double r[3], v[3];
+        if(Sgp4Propagator::Propagate(*elements.sgp4Records[k], t, r, v) != Sgp4Propagator::OK) {
+            state.x[i] = state.y[i] = state.z[i] = NOT_A_NUMBER;
+            state.vx[i] = state.vy[i] = state.vz[i] = NOT_A_NUMBER;
+            if(failed) failed->push_back(i);
+            continue;
+        }
+        
+        // TEME (X, Y, Z) -> render (X, Z, Y), as for the Kepler path
+        state.x[i] = (float)r[0]; state.y[i] = (float)r[2]; state.z[i] = (float)r[1];
+        state.vx[i] = (float)v[0]; state.vy[i] = (float)v[2]; state.vz[i] = (float)v[1];
+    }
+}
+}
+
+void ElementsSoA::clear() {
+    semiMajorAxis.clear(); eccentricity.clear(); meanMotion.clear();
+    meanAnomaly.clear(); meanAnomalyAtZero.clear(); sqrtOneMinusE2.clear();
+    px.clear(); py.clear(); pz.clear();
+    qx.clear(); qy.clear(); qz.clear();
+    sgp4Index.clear(); sgp4Records.clear();
+    epoch = 0.0;
+}
+
+void ElementsSoA::reserve(size_t count) {
+    semiMajorAxis.reserve(count); eccentricity.reserve(count); meanMotion.reserve(count);
+    meanAnomaly.reserve(count); meanAnomalyAtZero.reserve(count); sqrtOneMinusE2.reserve(count);
+    px.reserve(count); py.reserve(count); pz.reserve(count);
+    qx.reserve(count); qy.reserve(count); qz.reserve(count);
+}
+
+void ElementsSoA::add(const Satellite& sat) {
+    add(sat.elements(), sat.sgp4);
+}
+
+void ElementsSoA::add(const OrbitElements& orbit, const std::shared_ptr<const Sgp4Record>& sgp4) {
+    float a = orbit.semiMajorAxis;
+    float e = orbit.eccentricity;
+    
+    semiMajorAxis.push_back(a);
+    eccentricity.push_back(e);
+    meanMotion.push_back(std::sqrt(KeplerConst::MU / (a * a * a)));
+    meanAnomalyAtZero.push_back(orbit.meanAnomaly);
+    meanAnomaly.push_back(orbit.meanAnomaly);
+    sqrtOneMinusE2.push_back(std::sqrt(1.0f - e * e));
+    
+    float cO = std::cos(orbit.raan), sO = std::sin(orbit.raan);
+    float cw = std::cos(orbit.argPeriapsis), sw = std::sin(orbit.argPeriapsis);
+    float ci = std::cos(orbit.inclination), si = std::sin(orbit.inclination);
+    
+    // ECI perifocal axes, stored with ECI Z -> render Y (same mapping as CalculatePosition)
+    px.push_back(cO * cw - sO * sw * ci);
+    pz.push_back(sO * cw + cO * sw * ci);
+    py.push_back(sw * si);
+    
+    qx.push_back(-(cO * sw + sO * cw * ci));
+    qz.push_back(-(sO * sw - cO * cw * ci));
+    qy.push_back(cw * si);
+    
+    if(sgp4) {
+        sgp4Index.push_back(semiMajorAxis.size() - 1);
+        sgp4Records.push_back(sgp4);
+    }
+}
+
+void ElementsSoA::rebase(SimTime newEpoch) {
+    // Advance M in double: n * t reaches ~1e4 rad after a few days in LEO,
+    // where a float would keep only milliradians
+    const double MU = 398600.4418;
+    const double TWO_PI = 6.283185307179586;
+    for(size_t i = 0; i < size(); ++i) {
+        double a = semiMajorAxis[i];
+        double M = meanAnomalyAtZero[i] + std::sqrt(MU / (a * a * a)) * newEpoch;
+        meanAnomaly[i] = (float)(M - TWO_PI * std::floor(M / TWO_PI));
+    }
+    epoch = newEpoch;
+}
+
+void StateSoA::resize(size_t count) {
+    x.resize(count); y.resize(count); z.resize(count);
+    vx.resize(count); vy.resize(count); vz.resize(count);
+}
+
+void StateSoA::reserve(size_t count) {
+    x.reserve(count); y.reserve(count); z.reserve(count);
+    vx.reserve(count); vy.reserve(count); vz.reserve(count);
+}
+
+void OrbitPropagator::PropagateBatch(const ElementsSoA& elements, SimTime time, StateSoA& state,
+                                     std::vector<size_t>* failed) {
+    RunBatch(elements, nullptr, time, state, failed);
+}
+
+void OrbitPropagator::PropagateBatch(const ElementsSoA& elements, const std::vector<float>& times, StateSoA& state) {
+    RunBatch(elements, times.data(), elements.epoch, state, nullptr);
+}
+
+const char* OrbitPropagator::BatchIsaName() {
+    return Backend().name;
+}
@@ -0,0 +1,82 @@
+#include "SatelliteCatalog.h"
+#include "OrbitPropagator.h"
+#include "../util/BinaryCatalog.h"
+#include "../util/Log.h"
+#include <cmath>
+#include <sstream>
+
+namespace {
+const double ELEMENT_REBASE_INTERVAL = 3600.0; // s, keeps the batch kernel's float time offset small
+const size_t MAX_REPORTED_IDS = 8;
+}
+
+void SatelliteCatalog::addSatellite(const Satellite& sat) {
+    slotById.insert(sat.id, (uint32_t)satellites.size());
+    satellites.add(sat);
+    elementsDirty = true;
+}
+
+void SatelliteCatalog::reserve(size_t count) {
+    satellites.reserve(count);
+    slotById.reserve(count);
+}
+
+size_t SatelliteCatalog::addCatalog(const CatalogView& view) {
+    uint32_t base = (uint32_t)satellites.size();
+    slotById.reserve(slotById.size() + view.recordCount);
+    satellites.append(view);
+    
+    // The file's sorted index lists each id with its record; equal ids keep
+    // file order there, so the first record still wins
+    if(view.idIndex) {
+        for(size_t k = 0; k < view.recordCount; ++k) {
+            const CatalogIdEntry& e = view.idIndex[k];
+            if(e.record < view.recordCount) slotById.insert(e.id, base + e.record);
+        }
+    } else {
+        for(size_t k = 0; k < view.recordCount; ++k) slotById.insert(view.records[k].id, base + (uint32_t)k);
+    }
+    elementsDirty = true;
+    return view.recordCount;
+}
+
+void SatelliteCatalog::destroySatellite(int id) {
+    uint32_t slot = slotById.find(id);
+    if(slot == IdIndex::NOT_FOUND) return;
+    satellites.active.set(slot, false);
+    onSatelliteDestroyed(slot);
+    LOG_INFO_RATE(20, "Satellite " << id << " destroyed and removed from map.");
+}
+
+std::optional<SatelliteRef> SatelliteCatalog::findById(int id) const {
+    uint32_t slot = slotById.find(id);
+    if(slot == IdIndex::NOT_FOUND) return std::nullopt;
+    return satellites[slot];
+}
+
+void SatelliteCatalog::propagate(SimTime time) {
+    // The kernel writes straight into the store's state arrays, nothing to scatter back
+    ElementsSoA& elements = satellites.elements;
+    if(elementsDirty || std::fabs(time - elements.epoch) > ELEMENT_REBASE_INTERVAL) {
+        elements.rebase(time);
+        elementsDirty = false;
+    }
+    
+    failedSlots.clear();
+    OrbitPropagator::PropagateBatch(elements, time, satellites.state, &failedSlots);
+    if(failedSlots.empty()) return;
+    
+    // No valid state any more: out of the collision checks and the screening,
+    // reported once since they stay inactive
+    std::ostringstream ids;
+    size_t retired = 0;
+    for(size_t slot : failedSlots) {
+        if(!satellites.active.test(slot)) continue;
+        satellites.active.set(slot, false);
+        onSatelliteDestroyed(slot);
+        if(retired++ < MAX_REPORTED_IDS) ids << (retired > 1 ? ", " : "") << satellites.ids[slot];
+    }
+    if(retired > 0) {
+        LOG_WARN(retired << " TLE objects decayed (SGP4 error) at t=" << time << " s, removed (ids " << ids.str() << (retired > MAX_REPORTED_IDS ? ", ...)" : ")"));
+    }
+}
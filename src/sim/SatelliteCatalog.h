@@ -0,0 +1,46 @@
+#pragma once
+#include <optional>
+#include <vector>
+#include "../scene/Satellite.h"
+#include "SatelliteStore.h"
+#include "IdIndex.h"
+
+struct CatalogView;
+
+// Owns the simulated satellites without any rendering state, so the same
+// container drives both the windowed app and the headless screening tool.
+class SatelliteCatalog {
+public:
+    virtual ~SatelliteCatalog() = default;
+    
+    void addSatellite(const Satellite& sat);
+    void reserve(size_t count); // Total slots, before adding many satellites one by one
+    
+    // Bulk load of a mapped .satcat or checkpoint: the SoA columns are filled
+    // straight from its record table and the id index is sized once. Returns
+    // the number of records added (a repeated id keeps its first slot).
+    size_t addCatalog(const CatalogView& view);
+    void destroySatellite(int id); // Mark as inactive
+    
+    // Moves every satellite to sim time. TLE objects SGP4 can no longer
+    // propagate (decayed) are marked inactive, like destroyed ones.
+    void propagate(SimTime time);
+    
+    const SatelliteStore& getSatellites() const { return satellites; }
+    std::vector<Satellite> toSatellites() const { return satellites.toSatellites(); }
+    size_t getActiveCount() const { return satellites.activeCount(); }
+    
+    // O(1) lookup through the id index; empty for unknown ids. Destroyed
+    // satellites are still found (check isActive).
+    std::optional<SatelliteRef> findById(int id) const;
+    
+protected:
+    SatelliteStore satellites;
+    IdIndex slotById; // id -> slot in satellites, kept in step by addSatellite/addCatalog
+    
+    bool elementsDirty = true; // Batch elements need a rebase after satellites were added
+    std::vector<size_t> failedSlots; // SGP4 failures of the last propagation
+    
+    // Called after a slot is marked inactive, for state derived from the active set
+    virtual void onSatelliteDestroyed(size_t /*slot*/) {}
+};
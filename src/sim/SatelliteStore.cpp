@@ -0,0 +1,99 @@
+#include "SatelliteStore.h"
+#include "../util/BinaryCatalog.h"
+
+void SatelliteStore::clear() {
+    elements.clear();
+    state.resize(0);
+    active.clear();
+    ids.clear();
+    orbits.clear();
+    sgp4.clear();
+    names.clear();
+    namePool.clear();
+    colors.clear();
+}
+
+void SatelliteStore::reserve(size_t count) {
+    elements.reserve(count);
+    state.reserve(count);
+    active.reserve(count);
+    ids.reserve(count);
+    orbits.reserve(count);
+    sgp4.reserve(count);
+    names.reserve(count);
+    colors.reserve(count);
+}
+
+void SatelliteStore::add(const Satellite& sat) {
+    OrbitElements orbit = sat.elements();
+    elements.add(orbit, sat.sgp4);
+    active.push(sat.active);
+    ids.push_back(sat.id);
+    
+    orbits.push_back(orbit);
+    sgp4.push_back(sat.sgp4);
+    names.push_back({(uint32_t)namePool.size(), (uint32_t)sat.name.size()});
+    namePool += sat.name;
+    colors.push_back(sat.color);
+    
+    // Loaded state until the first propagation
+    state.x.push_back(sat.position.x); state.y.push_back(sat.position.y); state.z.push_back(sat.position.z);
+    state.vx.push_back(sat.velocity.x); state.vy.push_back(sat.velocity.y); state.vz.push_back(sat.velocity.z);
+}
+
+void SatelliteStore::append(const CatalogView& view) {
+    reserve(size() + view.recordCount);
+    
+    // Record name offsets stay valid against the copied pool, shifted by its start
+    uint32_t poolBase = (uint32_t)namePool.size();
+    namePool.append(view.strings, view.stringsSize);
+    
+    for(size_t k = 0; k < view.recordCount; ++k) {
+        const CatalogRecord& r = view.records[k];
+        OrbitElements orbit = {r.semiMajorAxis, r.eccentricity, r.inclination, r.raan, r.argPeriapsis, r.meanAnomaly};
+        
+        // Aliasing pointer: shares ownership of the mapping, points at the mapped record
+        std::shared_ptr<const Sgp4Record> record;
+        if(r.sgp4Index >= 0 && (uint64_t)r.sgp4Index < view.sgp4Count) {
+            record = std::shared_ptr<const Sgp4Record>(view.owner, &view.sgp4Table[r.sgp4Index]);
+        }
+        
+        elements.add(orbit, record);
+        active.push(!(r.flags & CATALOG_INACTIVE));
+        ids.push_back(r.id);
+        orbits.push_back(orbit);
+        sgp4.push_back(std::move(record));
+        bool nameValid = (uint64_t)r.nameOffset + r.nameLength <= view.stringsSize;
+        names.push_back({poolBase + (nameValid ? r.nameOffset : 0), nameValid ? r.nameLength : 0});
+        colors.push_back(glm::vec3(r.color[0], r.color[1], r.color[2]));
+    }
+    
+    // No state until the first propagation
+    state.resize(size());
+}
+
+Satellite SatelliteStore::get(size_t i) const {
+    const OrbitElements& orbit = orbits[i];
+    Satellite s;
+    s.id = ids[i];
+    s.name = name(i);
+    s.semiMajorAxis = orbit.semiMajorAxis;
+    s.eccentricity = orbit.eccentricity;
+    s.inclination = orbit.inclination;
+    s.raan = orbit.raan;
+    s.argPeriapsis = orbit.argPeriapsis;
+    s.meanAnomaly = orbit.meanAnomaly;
+    s.sgp4 = sgp4[i];
+    s.position = position(i);
+    s.velocity = velocity(i);
+    s.color = colors[i];
+    s.active = active.test(i);
+    return s;
+}
+
+std::vector<Satellite> SatelliteStore::toSatellites() const {
+    std::vector<Satellite> satellites;
+    satellites.reserve(size());
+    for(size_t i = 0; i < size(); ++i) satellites.push_back(get(i));
+    return satellites;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../scene/Satellite.h"
+#include "OrbitPropagator.h"
+#include "ActiveMask.h"
+
+class SatelliteRef;
+struct CatalogView;
+
+// The catalog in structure-of-arrays form, split by how often each field is
+// touched. Slot i of every table is the same satellite, in load order.
+//
+// Hot (every frame): the Kepler kernel inputs, the propagated state, the
+// active bitmask and the ids reported by collision checks. Propagation and
+// the distance loops stream through these contiguous float arrays only.
+//
+// Cold (load, save, UI, exact TCA refinement): loaded elements, SGP4 state,
+// names (one shared pool) and colours.
+struct SatelliteStore {
+    struct NameRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+    
+    ElementsSoA elements;   // Batch kernel input, derived from orbits
+    StateSoA state;         // ECI position (km) / velocity (km/s) at the last propagation
+    ActiveMask active;
+    std::vector<int> ids;
+    
+    std::vector<OrbitElements> orbits;
+    std::vector<std::shared_ptr<const Sgp4Record>> sgp4;
+    std::vector<NameRef> names; // Into namePool
+    std::string namePool;
+    std::vector<glm::vec3> colors;
+    
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+    size_t activeCount() const { return active.count(); }
+    
+    void clear();
+    void reserve(size_t count);
+    void add(const Satellite& sat); // Appends a slot; elements need rebase() before the next batch
+    
+    // Appends every record of a mapped catalog or checkpoint in one pass:
+    // columns reserved once, names copied as one block from its string pool
+    void append(const CatalogView& view);
+    
+    glm::vec3 position(size_t i) const { return state.position(i); }
+    glm::vec3 velocity(size_t i) const { return state.velocity(i); }
+    std::string_view name(size_t i) const { return std::string_view(namePool.data() + names[i].offset, names[i].length); }
+    
+    Satellite get(size_t i) const; // Reassembled copy (checkpoints, export)
+    std::vector<Satellite> toSatellites() const;
+    
+    // Range-for over lightweight per-slot views
+    class Iterator;
+    SatelliteRef operator[](size_t i) const;
+    Iterator begin() const;
+    Iterator end() const;
+};
+
+// View of one slot: an index into the store, with accessors for the fields
+class SatelliteRef {
+public:
+    SatelliteRef(const SatelliteStore* store, size_t index) : store(store), index(index) {}
+    
+    size_t slot() const { return index; }
+    int id() const { return store->ids[index]; }
+    bool isActive() const { return store->active.test(index); }
+    glm::vec3 position() const { return store->position(index); }
+    glm::vec3 velocity() const { return store->velocity(index); }
+    const OrbitElements& orbit() const { return store->orbits[index]; }
+    const Sgp4Record* sgp4() const { return store->sgp4[index].get(); }
+    std::string_view name() const { return store->name(index); }
+    const glm::vec3& color() const { return store->colors[index]; }
+
+private:
+    const SatelliteStore* store;
+    size_t index;
+};
+
+class SatelliteStore::Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SatelliteRef;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = SatelliteRef;
+    
+    Iterator(const SatelliteStore* store, size_t index) : store(store), index(index) {}
+    
+    SatelliteRef operator*() const { return SatelliteRef(store, index); }
+    Iterator& operator++() { ++index; return *this; }
+    Iterator operator++(int) { Iterator old = *this; ++index; return old; }
+    bool operator==(const Iterator& other) const { return index == other.index; }
+    bool operator!=(const Iterator& other) const { return index != other.index; }
+
+private:
+    const SatelliteStore* store;
+    size_t index;
+};
+
+inline SatelliteRef SatelliteStore::operator[](size_t i) const { return SatelliteRef(this, i); }
+inline SatelliteStore::Iterator SatelliteStore::begin() const { return Iterator(this, 0); }
+inline SatelliteStore::Iterator SatelliteStore::end() const { return Iterator(this, size()); }
@@ -0,0 +1,257 @@
+#include "Sgp4Propagator.h"
+#include <cmath>
+
+namespace {
+// WGS-72, the gravity model the published TLEs are fitted with
+const double RADIUS_EARTH_KM = 6378.135;
+const double MU = 398600.8;  // km^3/s^2
+const double XKE = 60.0 / std::sqrt(RADIUS_EARTH_KM * RADIUS_EARTH_KM * RADIUS_EARTH_KM / MU);
+const double J2 = 0.001082616;
+const double J3 = -0.00000253881;
+const double J4 = -0.00000165597;
+const double J3OJ2 = J3 / J2;
+
+const double TWO_PI = 6.283185307179586;
+const double X2O3 = 2.0 / 3.0;
+const double DEEP_SPACE_PERIOD = 225.0; // min
+}
+
+Sgp4Propagator::Status Sgp4Propagator::Initialize(const TleElements& el, Sgp4Record& rec) {
+    rec = Sgp4Record();
+    rec.elements = el;
+    
+    double ecco = el.eccentricity;
+    double inclo = el.inclination;
+    double argpo = el.argPeriapsis;
+    double bstar = el.bstar;
+    
+    if(ecco < 0.0 || ecco >= 1.0) return BAD_ECCENTRICITY;
+    if(el.meanMotion <= 0.0) return BAD_MEAN_MOTION;
+    
+    // Recover the original mean motion and semi-major axis from the Kozai mean motion
+    double eccsq = ecco * ecco;
+    double omeosq = 1.0 - eccsq;
+    double rteosq = std::sqrt(omeosq);
+    double cosio = std::cos(inclo);
+    double cosio2 = cosio * cosio;
+    
+    double ak = std::pow(XKE / el.meanMotion, X2O3);
+    double d1 = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    double no = el.meanMotion / (1.0 + del);
+    double ao = std::pow(XKE / no, X2O3);
+    
+    double sinio = std::sin(inclo);
+    double po = ao * omeosq;
+    double con42 = 1.0 - 5.0 * cosio2;
+    double con41 = -con42 - cosio2 - cosio2;
+    double posq = po * po;
+    double rp = ao * (1.0 - ecco);
+    
+    rec.no = no;
+    rec.ao = ao;
+    rec.con41 = con41;
+    rec.deepSpace = (TWO_PI / no >= DEEP_SPACE_PERIOD);
+    rec.isimp = rec.deepSpace || (rp < 220.0 / RADIUS_EARTH_KM + 1.0);
+    
+    // Atmospheric density parameters, lowered for perigees below 156 km
+    double ss = 78.0 / RADIUS_EARTH_KM + 1.0;
+    double qzms2t = std::pow((120.0 - 78.0) / RADIUS_EARTH_KM, 4);
+    double sfour = ss;
+    double qzms24 = qzms2t;
+    double perige = (rp - 1.0) * RADIUS_EARTH_KM;
+    if(perige < 156.0) {
+        sfour = (perige < 98.0) ? 20.0 : perige - 78.0;
+        qzms24 = std::pow((120.0 - sfour) / RADIUS_EARTH_KM, 4);
+        sfour = sfour / RADIUS_EARTH_KM + 1.0;
+    }
+    
+    double pinvsq = 1.0 / posq;
+    double tsi = 1.0 / (ao - sfour);
+    double eta = ao * ecco * tsi;
+    double etasq = eta * eta;
+    double eeta = ecco * eta;
+    double psisq = std::fabs(1.0 - etasq);
+    double coef = qzms24 * std::pow(tsi, 4);
+    double coef1 = coef / std::pow(psisq, 3.5);
+    double cc2 = coef1 * no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                 0.375 * J2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    double cc1 = bstar * cc2;
+    double cc3 = (ecco > 1.0e-4) ? -2.0 * coef * tsi * J3OJ2 * no * sinio / ecco : 0.0;
+    double x1mth2 = 1.0 - cosio2;
+    
+    rec.eta = eta;
+    rec.cc1 = cc1;
+    rec.x1mth2 = x1mth2;
+    rec.cc4 = 2.0 * no * coef1 * ao * omeosq *
+              (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+               J2 * tsi / (ao * psisq) *
+               (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * argpo)));
+    rec.cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+    
+    // Secular rates from J2/J4
+    double cosio4 = cosio2 * cosio2;
+    double temp1 = 1.5 * J2 * pinvsq * no;
+    double temp2 = 0.5 * temp1 * J2 * pinvsq;
+    double temp3 = -0.46875 * J4 * pinvsq * pinvsq * no;
+    rec.mdot = no + 0.5 * temp1 * rteosq * con41 + 0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    rec.argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+                  temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    double xhdot1 = -temp1 * cosio;
+    rec.nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+    
+    rec.omgcof = bstar * cc3 * std::cos(argpo);
+    rec.xmcof = (ecco > 1.0e-4) ? -X2O3 * coef * bstar / eeta : 0.0;
+    rec.nodecf = 3.5 * omeosq * xhdot1 * cc1;
+    rec.t2cof = 1.5 * cc1;
+    
+    // Long-period J3 terms; guard the 1 + cos(i) division for retrograde equatorial orbits
+    double denom = (std::fabs(cosio + 1.0) > 1.5e-12) ? (1.0 + cosio) : 1.5e-12;
+    rec.xlcof = -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / denom;
+    rec.aycof = -0.5 * J3OJ2 * sinio;
+    rec.delmo = std::pow(1.0 + eta * std::cos(el.meanAnomaly), 3);
+    rec.sinmao = std::sin(el.meanAnomaly);
+    rec.x7thm1 = 7.0 * cosio2 - 1.0;
+    
+    if(!rec.isimp) {
+        double cc1sq = cc1 * cc1;
+        rec.d2 = 4.0 * ao * tsi * cc1sq;
+        double temp = rec.d2 * tsi * cc1 / 3.0;
+        rec.d3 = (17.0 * ao + sfour) * temp;
+        rec.d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+        rec.t3cof = rec.d2 + 2.0 * cc1sq;
+        rec.t4cof = 0.25 * (3.0 * rec.d3 + cc1 * (12.0 * rec.d2 + 10.0 * cc1sq));
+        rec.t5cof = 0.2 * (3.0 * rec.d4 + 12.0 * cc1 * rec.d3 + 6.0 * rec.d2 * rec.d2 +
+                           15.0 * cc1sq * (2.0 * rec.d2 + cc1sq));
+    }
+    
+    // Evaluate at epoch once so invalid element sets are rejected up front
+    double r[3], v[3];
+    return Propagate(rec, el.epoch, r, v);
+}
+
+Sgp4Propagator::Status Sgp4Propagator::Propagate(const Sgp4Record& rec, SimTime time,
+                                                 double position[3], double velocity[3]) {
+    const TleElements& el = rec.elements;
+    double t = (time - el.epoch) / 60.0; // Minutes since the element epoch
+    
+    // Secular gravity and atmospheric drag
+    double xmdf = el.meanAnomaly + rec.mdot * t;
+    double argpdf = el.argPeriapsis + rec.argpdot * t;
+    double nodedf = el.raan + rec.nodedot * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    double t2 = t * t;
+    double nodem = nodedf + rec.nodecf * t2;
+    double tempa = 1.0 - rec.cc1 * t;
+    double tempe = el.bstar * rec.cc4 * t;
+    double templ = rec.t2cof * t2;
+    
+    if(!rec.isimp) {
+        double delomg = rec.omgcof * t;
+        double delm = rec.xmcof * (std::pow(1.0 + rec.eta * std::cos(xmdf), 3) - rec.delmo);
+        double temp = delomg + delm;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        double t3 = t2 * t;
+        double t4 = t3 * t;
+        tempa = tempa - rec.d2 * t2 - rec.d3 * t3 - rec.d4 * t4;
+        tempe = tempe + el.bstar * rec.cc5 * (std::sin(mm) - rec.sinmao);
+        templ = templ + rec.t3cof * t3 + t4 * (rec.t4cof + t * rec.t5cof);
+    }
+    
+    double nm = rec.no;
+    double am = std::pow(XKE / nm, X2O3) * tempa * tempa;
+    nm = XKE / std::pow(am, 1.5);
+    double em = el.eccentricity - tempe;
+    if(em >= 1.0 || em < -0.001) return BAD_ECCENTRICITY;
+    if(em < 1.0e-6) em = 1.0e-6;
+    
+    mm = mm + rec.no * templ;
+    double xlm = mm + argpm + nodem;
+    nodem = std::fmod(nodem, TWO_PI);
+    argpm = std::fmod(argpm, TWO_PI);
+    xlm = std::fmod(xlm, TWO_PI);
+    mm = std::fmod(xlm - argpm - nodem, TWO_PI);
+    
+    double sinim = std::sin(el.inclination);
+    double cosim = std::cos(el.inclination);
+    
+    // Long-period periodics
+    double axnl = em * std::cos(argpm);
+    double temp = 1.0 / (am * (1.0 - em * em));
+    double aynl = em * std::sin(argpm) + temp * rec.aycof;
+    double xl = mm + argpm + nodem + temp * rec.xlcof * axnl;
+    
+    // Kepler's equation in the modified (equinoctial-like) form
+    double u = std::fmod(xl - nodem, TWO_PI);
+    double eo1 = u;
+    double sineo1 = 0.0, coseo1 = 1.0;
+    double tem5 = 9999.9;
+    for(int ktr = 1; std::fabs(tem5) >= 1.0e-12 && ktr <= 10; ++ktr) {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+        tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+        if(std::fabs(tem5) >= 0.95) tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+        eo1 += tem5;
+    }
+    
+    // Short-period periodics
+    double ecose = axnl * coseo1 + aynl * sineo1;
+    double esine = axnl * sineo1 - aynl * coseo1;
+    double el2 = axnl * axnl + aynl * aynl;
+    double pl = am * (1.0 - el2);
+    if(pl < 0.0) return BAD_SEMI_LATUS;
+    
+    double rl = am * (1.0 - ecose);
+    double rdotl = std::sqrt(am) * esine / rl;
+    double rvdotl = std::sqrt(pl) / rl;
+    double betal = std::sqrt(1.0 - el2);
+    temp = esine / (1.0 + betal);
+    double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+    double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+    double su = std::atan2(sinu, cosu);
+    double sin2u = (cosu + cosu) * sinu;
+    double cos2u = 1.0 - 2.0 * sinu * sinu;
+    temp = 1.0 / pl;
+    double temp1 = 0.5 * J2 * temp;
+    double temp2 = temp1 * temp;
+    
+    double mrt = rl * (1.0 - 1.5 * temp2 * betal * rec.con41) + 0.5 * temp1 * rec.x1mth2 * cos2u;
+    su = su - 0.25 * temp2 * rec.x7thm1 * sin2u;
+    double xnode = nodem + 1.5 * temp2 * cosim * sin2u;
+    double xinc = el.inclination + 1.5 * temp2 * cosim * sinim * cos2u;
+    double mvt = rdotl - nm * temp1 * rec.x1mth2 * sin2u / XKE;
+    double rvdot = rvdotl + nm * temp1 * (rec.x1mth2 * cos2u + 1.5 * rec.con41) / XKE;
+    
+    // Orientation vectors
+    double sinsu = std::sin(su), cossu = std::cos(su);
+    double snod = std::sin(xnode), cnod = std::cos(xnode);
+    double sini = std::sin(xinc), cosi = std::cos(xinc);
+    double xmx = -snod * cosi;
+    double xmy = cnod * cosi;
+    double ux = xmx * sinsu + cnod * cossu;
+    double uy = xmy * sinsu + snod * cossu;
+    double uz = sini * sinsu;
+    double vx = xmx * cossu - cnod * sinsu;
+    double vy = xmy * cossu - snod * sinsu;
+    double vz = sini * cossu;
+    
+    const double VKMPERSEC = RADIUS_EARTH_KM * XKE / 60.0;
+    position[0] = mrt * ux * RADIUS_EARTH_KM;
+    position[1] = mrt * uy * RADIUS_EARTH_KM;
+    position[2] = mrt * uz * RADIUS_EARTH_KM;
+    velocity[0] = (mvt * ux + rvdot * vx) * VKMPERSEC;
+    velocity[1] = (mvt * uy + rvdot * vy) * VKMPERSEC;
+    velocity[2] = (mvt * uz + rvdot * vz) * VKMPERSEC;
+    
+    return (mrt < 1.0) ? DECAYED : OK;
+}
+
+double Sgp4Propagator::SemiMajorAxisKm(const Sgp4Record& record) {
+    return record.ao * RADIUS_EARTH_KM;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include "SimTime.h"
+
+// Mean elements of one TLE, in the units SGP4 works with
+struct TleElements {
+    SimTime epoch;        // Sim time of the element set (s)
+    double meanMotion;    // Kozai mean motion (rad/min)
+    double eccentricity;
+    double inclination;   // rad
+    double raan;          // rad
+    double argPeriapsis;  // rad
+    double meanAnomaly;   // rad
+    double bstar;         // Drag term (1/earth radii)
+};
+
+// SGP4 state initialized once per element set, so propagation to any time is
+// a closed-form evaluation. Records are immutable after Initialize and can be
+// shared by any number of threads.
+struct Sgp4Record {
+    TleElements elements;
+    
+    bool isimp;           // Simplified drag model (perigee < 220 km or deep space)
+    bool deepSpace;       // Period >= 225 min (lunar/solar terms not modelled)
+    
+    double no;            // Un-Kozai'd mean motion (rad/min)
+    double ao;            // Semi-major axis (earth radii)
+    double con41, x1mth2, x7thm1;
+    double cc1, cc4, cc5, d2, d3, d4;
+    double delmo, eta, sinmao;
+    double mdot, argpdot, nodedot, nodecf;
+    double omgcof, xmcof, xlcof, aycof;
+    double t2cof, t3cof, t4cof, t5cof;
+};
+
+class Sgp4Propagator {
+public:
+    enum Status {
+        OK = 0,
+        BAD_ECCENTRICITY = 1,  // Mean eccentricity left [0, 1)
+        BAD_MEAN_MOTION = 2,
+        BAD_SEMI_LATUS = 4,
+        DECAYED = 6            // Orbit radius below the Earth's surface
+    };
+    
+    // Near-Earth SGP4 (Hoots & Roehrich, Vallado 2006 revision) with WGS-72 constants
+    static Status Initialize(const TleElements& elements, Sgp4Record& record);
+    
+    // TEME position (km) and velocity (km/s) at sim time
+    static Status Propagate(const Sgp4Record& record, SimTime time, double position[3], double velocity[3]);
+    
+    // Mean semi-major axis (km), used to fill the two-body elements of TLE objects
+    static double SemiMajorAxisKm(const Sgp4Record& record);
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+// Simulation time in seconds since the scenario epoch. Double precision keeps
+// sub-microsecond resolution over years of simulated time; a float would lose
+// tens of milliseconds after a few days, i.e. hundreds of metres at LEO speed.
+using SimTime = double;
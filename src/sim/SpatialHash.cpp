@@ -0,0 +1,93 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 21 bits per axis, biased so negative cells pack as unsigned values
+const int CELL_BIAS = 1 << 20;
+const uint64_t CELL_MASK = (1u << 21) - 1;
+
+// Half of the 26-neighbourhood: visiting only these from every cell reports
+// each neighbouring cell pair exactly once.
+const int HALF_SHELL[13][3] = {
+    { 1, 0, 0}, {-1, 1, 0}, { 0, 1, 0}, { 1, 1, 0},
+    {-1,-1, 1}, { 0,-1, 1}, { 1,-1, 1},
+    {-1, 0, 1}, { 0, 0, 1}, { 1, 0, 1},
+    {-1, 1, 1}, { 0, 1, 1}, { 1, 1, 1}
+};
+}
+
+SpatialHash::SpatialHash(float cellSize) : cellSize(cellSize) {
+}
+
+uint64_t SpatialHash::cellKey(int ix, int iy, int iz) const {
+    return ((uint64_t)((ix + CELL_BIAS) & CELL_MASK) << 42) |
+           ((uint64_t)((iy + CELL_BIAS) & CELL_MASK) << 21) |
+            (uint64_t)((iz + CELL_BIAS) & CELL_MASK);
+}
+
+void SpatialHash::build(const SatelliteStore& satellites) {
+    entries.clear();
+    cells.clear();
+    
+    // Reads only the position arrays and the active bitmask
+    const float* px = satellites.state.x.data();
+    const float* py = satellites.state.y.data();
+    const float* pz = satellites.state.z.data();
+    float invCell = 1.0f / cellSize;
+    satellites.active.forEach([&](size_t i) {
+        int ix = (int)std::floor(px[i] * invCell);
+        int iy = (int)std::floor(py[i] * invCell);
+        int iz = (int)std::floor(pz[i] * invCell);
+        entries.push_back({cellKey(ix, iy, iz), (int)i});
+    });
+    
+    // Sorting by (key, index) keeps every cell contiguous and its members in catalog order
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.key != b.key ? a.key < b.key : a.index < b.index;
+    });
+    
+    cells.reserve(entries.size());
+    size_t begin = 0;
+    while(begin < entries.size()) {
+        size_t end = begin + 1;
+        while(end < entries.size() && entries[end].key == entries[begin].key) ++end;
+        cells[entries[begin].key] = {(int)begin, (int)end};
+        begin = end;
+    }
+}
+
+void SpatialHash::collectCandidatePairs(std::vector<std::pair<int,int>>& pairs) const {
+    pairs.clear();
+    
+    for(const auto& cell : cells) {
+        uint64_t key = cell.first;
+        int begin = cell.second.first;
+        int end = cell.second.second;
+        
+        // Pairs inside the cell
+        for(int a = begin; a < end; ++a) {
+            for(int b = a + 1; b < end; ++b) {
+                pairs.push_back({entries[a].index, entries[b].index});
+            }
+        }
+        
+        // Pairs with the forward half of the neighbouring cells
+        int ix = (int)((key >> 42) & CELL_MASK) - CELL_BIAS;
+        int iy = (int)((key >> 21) & CELL_MASK) - CELL_BIAS;
+        int iz = (int)(key & CELL_MASK) - CELL_BIAS;
+        
+        for(const auto& offset : HALF_SHELL) {
+            auto neighbour = cells.find(cellKey(ix + offset[0], iy + offset[1], iz + offset[2]));
+            if(neighbour == cells.end()) continue;
+            
+            for(int a = begin; a < end; ++a) {
+                for(int b = neighbour->second.first; b < neighbour->second.second; ++b) {
+                    int i = entries[a].index;
+                    int j = entries[b].index;
+                    pairs.push_back(i < j ? std::make_pair(i, j) : std::make_pair(j, i));
+                }
+            }
+        }
+    }
+}
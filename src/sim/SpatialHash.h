@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <glm/glm.hpp>
+#include "SatelliteStore.h"
+
+// Uniform-grid broad phase. Objects are binned into cubic cells of cellSize,
+// so any two objects closer than cellSize are guaranteed to sit in the same
+// or in neighbouring cells. Storage is reused between frames.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize);
+    
+    void setCellSize(float size) { cellSize = size; }
+    float getCellSize() const { return cellSize; }
+    
+    // Bin every active satellite by its current position
+    void build(const SatelliteStore& satellites);
+    
+    // Index pairs (i < j, slots in the store) that share a cell
+    // or touch neighbouring cells. Each pair is reported once, in no particular order.
+    void collectCandidatePairs(std::vector<std::pair<int,int>>& pairs) const;
+    
+private:
+    struct Entry {
+        uint64_t key;
+        int index;
+    };
+    
+    float cellSize;
+    std::vector<Entry> entries;                      // Sorted by cell key
+    std::unordered_map<uint64_t, std::pair<int,int>> cells; // key -> [begin, end) in entries
+    
+    uint64_t cellKey(int ix, int iy, int iz) const;
+};
@@ -1,126 +1,377 @@
 #include "ConjunctionAnalyzer.h"
 #include "../OrbitPropagator.h"
-#include "../../scene/SatelliteSystem.h"
+#include "../SatelliteStore.h"
+#include "../Sgp4Propagator.h"
+#include "OrbitBandFilter.h"
+#include <limits>
 #include <cmath>
 #include <algorithm>
-#include <iostream>
+#include <unordered_set>
+#include "../../util/Log.h"
+
+namespace {
+const float MU = 398600.4418f; // Earth gravitational parameter km^3/s^2
+const size_t PAIR_CHUNK_SIZE = 256; // Candidate pairs claimed per work item
+
+// Brent's method for a root of f on [a, b], given f(a) and f(b) of opposite sign
+template<typename Real, typename F>
+Real brentRoot(F f, Real a, Real b, Real fa, Real fb, Real tol) {
+    const Real EPS = std::numeric_limits<Real>::epsilon();
+    Real c = b, fc = fb;
+    Real d = b - a, e = d;
+    
+    for(int iter = 0; iter < 50; ++iter) {
+        if((fb > Real(0) && fc > Real(0)) || (fb < Real(0) && fc < Real(0))) {
+            c = a; fc = fa;
+            d = e = b - a;
+        }
+        if(std::fabs(fc) < std::fabs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        
+        Real tol1 = Real(2) * EPS * std::fabs(b) + Real(0.5) * tol;
+        Real xm = Real(0.5) * (c - b);
+        if(std::fabs(xm) <= tol1 || fb == Real(0)) return b;
+        
+        if(std::fabs(e) >= tol1 && std::fabs(fa) > std::fabs(fb)) {
+            // Inverse quadratic interpolation (secant if only two points)
+            Real s = fb / fa;
+            Real p, q;
+            if(a == c) {
+                p = Real(2) * xm * s;
+                q = Real(1) - s;
+            } else {
+                Real qa = fa / fc;
+                Real r = fb / fc;
+                p = s * (Real(2) * xm * qa * (qa - r) - (b - a) * (r - Real(1)));
+                q = (qa - Real(1)) * (r - Real(1)) * (s - Real(1));
+            }
+            if(p > Real(0)) q = -q;
+            p = std::fabs(p);
+            
+            if(Real(2) * p < std::min(Real(3) * xm * q - std::fabs(tol1 * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = xm; // Fall back to bisection
+                e = d;
+            }
+        } else {
+            d = xm;
+            e = d;
+        }
+        
+        a = b;
+        fa = fb;
+        b += (std::fabs(d) > tol1) ? d : (xm >= Real(0) ? tol1 : -tol1);
+        fb = f(b);
+    }
+    return b;
+}
+}
 
 ConjunctionAnalyzer::ConjunctionAnalyzer() 
     : minDistanceThreshold(10.0f)
     , riskScoreThreshold(50.0f)
-    , predictionSteps(120) // 120 steps over prediction window
+    , predictionSteps(120) // 120 coarse steps over prediction window (brackets only)
+    , tcaTolerance(1.0e-3f)
+    , lastPrunedPairs(0)
+    , hasScreenedWindow(false)
+    , screenedUntil(0.0)
+    , screenedSatelliteCount(0)
+    , threadCount(ThreadPool::DefaultThreadCount())
 {
 }
 
+ConjunctionAnalyzer::~ConjunctionAnalyzer() = default;
+
+void ConjunctionAnalyzer::setThreadCount(int count) {
+    count = std::max(count, 1);
+    if(count == threadCount) return;
+    threadCount = count;
+    pool.reset(); // Recreated with the new size on the next analysis
+}
+
 void ConjunctionAnalyzer::analyzeFutureConjunctions(
-    const std::vector<Satellite>& satellites,
-    float currentTime,
+    const SatelliteStore& satellites,
+    SimTime currentTime,
     float predictionWindow)
 {
     events.clear();
-    criticalEvents.clear();
+    size_t activePairs = screenWindow(satellites, currentTime, currentTime + predictionWindow, predictionSteps, true);
+    rebuildCriticalEvents();
     
-    // Analyze all pairs
-    for(size_t i = 0; i < satellites.size(); ++i) {
-        if(!satellites[i].active) continue;
-        
-        for(size_t j = i + 1; j < satellites.size(); ++j) {
-            if(!satellites[j].active) continue;
+    hasScreenedWindow = true;
+    screenedUntil = currentTime + predictionWindow;
+    screenedSatelliteCount = satellites.size();
+    
+    LOG_INFO_RATE(5, "Conjunction Analysis: Found " << events.size()
+                  << " conjunctions (" << criticalEvents.size() << " critical), "
+                  << lastPrunedPairs << "/" << activePairs << " pairs pruned by orbit bands");
+}
+
+void ConjunctionAnalyzer::updateFutureConjunctions(
+    const SatelliteStore& satellites,
+    SimTime currentTime,
+    float predictionWindow)
+{
+    SimTime windowEnd = currentTime + predictionWindow;
+    
+    // New satellites need every pair screened; a gap or backwards jump leaves nothing to reuse
+    if(!hasScreenedWindow || satellites.size() != screenedSatelliteCount ||
+       currentTime >= screenedUntil || windowEnd < screenedUntil) {
+        analyzeFutureConjunctions(satellites, currentTime, predictionWindow);
+        return;
+    }
+    if(windowEnd == screenedUntil) return;
+    
+    // Drop passed events, events of destroyed satellites and minima clipped to the old
+    // window end (the slice below finds the true minimum or re-adds the edge)
+    clearOldEvents(currentTime);
+    std::unordered_set<int> inactiveIds;
+    for(const auto sat : satellites) {
+        if(!sat.isActive()) inactiveIds.insert(sat.id());
+    }
+    events.erase(
+        std::remove_if(events.begin(), events.end(),
+            [&](const ConjunctionEvent& e) {
+                return e.provisional || inactiveIds.count(e.sat1_id) || inactiveIds.count(e.sat2_id);
+            }),
+        events.end()
+    );
+    
+    // Screen only the newly exposed slice at the coarse step of a full analysis.
+    // Its start sample is the old window end, already covered, so no start-edge minima.
+    float coarseStep = predictionWindow / predictionSteps;
+    float slice = (float)(windowEnd - screenedUntil);
+    int steps = std::max(1, (int)std::ceil(slice / coarseStep));
+    screenWindow(satellites, screenedUntil, windowEnd, steps, false);
+    rebuildCriticalEvents();
+    
+    screenedUntil = windowEnd;
+    
+    LOG_INFO_RATE(5, "Conjunction Analysis: Found " << events.size()
+                  << " conjunctions (" << criticalEvents.size() << " critical), screened +"
+                  << slice << " s");
+}
+
+size_t ConjunctionAnalyzer::screenWindow(const SatelliteStore& satellites, SimTime startTime, SimTime endTime,
+                                       int steps, bool includeStartEdge) {
+    if(!pool) pool = std::make_unique<ThreadPool>(threadCount);
+    
+    // Propagate every active satellite once per step for the whole window
+    ephemeris.build(satellites, startTime, endTime, steps, pool.get());
+    
+    // Radial band pre-filter: drop pairs whose perigee/apogee ranges never come
+    // within threshold (SGP4 objects use their sampled radius range)
+    size_t activePairs = OrbitBandFilter::BuildCandidatePairs(satellites, ephemeris, minDistanceThreshold, candidatePairs);
+    lastPrunedPairs = activePairs - candidatePairs.size();
+    
+    // Screen candidate pairs in parallel, each worker appending to its own buffer
+    threadEvents.resize(pool->getThreadCount());
+    for(auto& buffer : threadEvents) buffer.clear();
+    
+    pool->parallelFor(candidatePairs.size(), PAIR_CHUNK_SIZE, [&](size_t begin, size_t end, int worker) {
+        std::vector<ClosestApproach> approaches;
+        for(size_t p = begin; p < end; ++p) {
+            size_t i = candidatePairs[p].first;
+            size_t j = candidatePairs[p].second;
             
-            // Find closest approach in prediction window
-            auto approach = findClosestApproach(
-                satellites[i],
-                satellites[j],
-                currentTime,
-                currentTime + predictionWindow,
-                predictionSteps
-            );
+            // Every local minimum of the pair's separation that falls below threshold
+            approaches.clear();
+            findCloseApproaches(satellites[i], satellites[j], ephemeris.rowOf(i), ephemeris.rowOf(j),
+                                includeStartEdge, approaches);
             
-            // Only record if within threshold
-            if(approach.distance < minDistanceThreshold) {
-                ConjunctionEvent event;
-                event.sat1_id = satellites[i].id;
-                event.sat2_id = satellites[j].id;
-                event.tca_time = approach.time;
-                event.tca_position = approach.position;
-                event.min_distance = approach.distance;
-                
-                // Calculate relative velocity
-                glm::vec3 relVel = approach.vel1 - approach.vel2;
-                event.relative_velocity = glm::length(relVel);
-                
-                // Estimate collision energy (simplified: v^2 * proxy_mass)
-                float proxyMass = 1000.0f; // kg (typical small satellite)
-                event.collision_energy = estimateCollisionEnergy(
-                    event.relative_velocity,
-                    proxyMass,
-                    proxyMass
-                );
-                
-                // Calculate risk score
-                float altitude = glm::length(event.tca_position);
-                event.risk_score = calculateRiskScore(
-                    event.min_distance,
-                    event.relative_velocity,
-                    altitude
-                );
-                
-                event.risk_level = determineRiskLevel(event.min_distance);
-                event.is_active = true;
-                event.sat1_velocity_at_tca = approach.vel1;
-                event.sat2_velocity_at_tca = approach.vel2;
-                
-                events.push_back(event);
-                
-                // Cache critical events
-                if(event.risk_level >= RiskLevel::HIGH) {
-                    criticalEvents.push_back(event);
-                }
+            for(const auto& approach : approaches) {
+                threadEvents[worker].push_back({p, makeEvent(satellites[i], satellites[j], approach)});
             }
         }
+    });
+    
+    // Merge in candidate-pair order; a pair's events are already in TCA order
+    // inside one buffer, so the result matches the serial loop exactly
+    std::vector<IndexedEvent> merged;
+    for(auto& buffer : threadEvents) merged.insert(merged.end(), buffer.begin(), buffer.end());
+    std::stable_sort(merged.begin(), merged.end(), [](const IndexedEvent& a, const IndexedEvent& b) {
+        return a.pairIndex < b.pairIndex;
+    });
+    
+    for(const auto& entry : merged) events.push_back(entry.event);
+    return activePairs;
+}
+
+void ConjunctionAnalyzer::restoreState(const ConjunctionEvent* savedEvents, size_t count,
+                                       const ScreeningState& screening) {
+    events.assign(savedEvents, savedEvents + count);
+    rebuildCriticalEvents();
+    hasScreenedWindow = screening.valid;
+    screenedUntil = screening.screenedUntil;
+    screenedSatelliteCount = screening.satelliteCount;
+}
+
+void ConjunctionAnalyzer::rebuildCriticalEvents() {
+    criticalEvents.clear();
+    for(const auto& event : events) {
+        if(event.risk_level >= RiskLevel::HIGH) {
+            criticalEvents.push_back(event);
+        }
     }
+}
+
+ConjunctionEvent ConjunctionAnalyzer::makeEvent(const SatelliteRef& sat1, const SatelliteRef& sat2, const ClosestApproach& approach) const {
+    ConjunctionEvent event;
+    event.sat1_id = sat1.id();
+    event.sat2_id = sat2.id();
+    event.tca_time = approach.time;
+    event.tca_position = approach.position;
+    event.min_distance = approach.distance;
     
-    std::cout << "Conjunction Analysis: Found " << events.size() 
-              << " conjunctions (" << criticalEvents.size() << " critical)" << std::endl;
+    // Calculate relative velocity
+    glm::vec3 relVel = approach.vel1 - approach.vel2;
+    event.relative_velocity = glm::length(relVel);
+    
+    // Estimate collision energy (simplified: v^2 * proxy_mass)
+    float proxyMass = 1000.0f; // kg (typical small satellite)
+    event.collision_energy = estimateCollisionEnergy(
+        event.relative_velocity,
+        proxyMass,
+        proxyMass
+    );
+    
+    // Calculate risk score
+    float altitude = glm::length(event.tca_position);
+    event.risk_score = calculateRiskScore(
+        event.min_distance,
+        event.relative_velocity,
+        altitude
+    );
+    
+    event.risk_level = determineRiskLevel(event.min_distance);
+    event.is_active = true;
+    event.provisional = approach.provisional;
+    event.deep_space = (sat1.sgp4() && sat1.sgp4()->deepSpace) || (sat2.sgp4() && sat2.sgp4()->deepSpace);
+    event.sat1_velocity_at_tca = approach.vel1;
+    event.sat2_velocity_at_tca = approach.vel2;
+    return event;
 }
 
-ConjunctionAnalyzer::ClosestApproach ConjunctionAnalyzer::findClosestApproach(
-    const Satellite& sat1,
-    const Satellite& sat2,
-    float startTime,
-    float endTime,
-    int steps)
+void ConjunctionAnalyzer::findCloseApproaches(
+    const SatelliteRef& sat1,
+    const SatelliteRef& sat2,
+    int row1,
+    int row2,
+    bool includeStartEdge,
+    std::vector<ClosestApproach>& out) const
 {
-    ClosestApproach result;
-    result.distance = std::numeric_limits<float>::max();
-    result.time = startTime;
+    // Stage 1: coarse scan of the cached samples. The separation has a local
+    // minimum wherever the range-rate sign (dr . dv) goes from - to +.
+    // Stage 2: each bracket is refined with Brent's method on the cubic
+    // Hermite interpolant of the relative state, so the refinement itself
+    // needs no propagation; only accepted TCAs are propagated exactly.
+    // A TLE object that decays in the window is only screened up to then.
+    int samples = std::min(ephemeris.getValidSampleCount(row1), ephemeris.getValidSampleCount(row2));
+    bool wholeWindow = samples == ephemeris.getSampleCount();
+    if(samples == 0) return;
+    float h = ephemeris.getStepSize();
     
-    float dt = (endTime - startTime) / steps;
+    RelativeSample prev = relativeSample(row1, row2, 0);
     
-    for(int i = 0; i <= steps; ++i) {
-        float t = startTime + i * dt;
-        
-        // Propagate both satellites to time t
-        glm::vec3 pos1 = OrbitPropagator::CalculatePosition(sat1, t);
-        glm::vec3 pos2 = OrbitPropagator::CalculatePosition(sat2, t);
-        glm::vec3 vel1 = OrbitPropagator::CalculateVelocity(sat1, t);
-        glm::vec3 vel2 = OrbitPropagator::CalculateVelocity(sat2, t);
-        
-        float dist = glm::distance(pos1, pos2);
+    // Already receding at the start of the window: the window edge is a minimum
+    if(includeStartEdge && prev.rangeRate >= 0.0f) addSampleApproach(row1, row2, 0, false, out);
+    
+    for(int k = 0; k + 1 < samples; ++k) {
+        RelativeSample next = relativeSample(row1, row2, k + 1);
         
-        if(dist < result.distance) {
-            result.distance = dist;
-            result.time = t;
-            result.position = (pos1 + pos2) * 0.5f;
-            result.vel1 = vel1;
-            result.vel2 = vel2;
+        if(prev.rangeRate < 0.0f && next.rangeRate >= 0.0f && bracketCanReach(row1, row2, k, prev, next, h)) {
+            // Refinement and the exact evaluation run in double: TCA is an absolute
+            // sim time and the miss distance a small difference of large vectors
+            SimTime t = ephemeris.getTime(k) + refineBracket(prev, next, h);
+            
+            glm::dvec3 pos1, vel1, pos2, vel2;
+            bool valid = OrbitPropagator::CalculateState(sat1.orbit(), sat1.sgp4(), t, pos1, vel1) &&
+                         OrbitPropagator::CalculateState(sat2.orbit(), sat2.sgp4(), t, pos2, vel2);
+            double dist = valid ? glm::distance(pos1, pos2) : 0.0;
+            
+            if(valid && dist < minDistanceThreshold) {
+                ClosestApproach approach;
+                approach.time = t;
+                approach.distance = (float)dist;
+                approach.position = glm::vec3((pos1 + pos2) * 0.5);
+                approach.vel1 = glm::vec3(vel1);
+                approach.vel2 = glm::vec3(vel2);
+                approach.provisional = false;
+                out.push_back(approach);
+            }
         }
+        prev = next;
     }
     
-    return result;
+    // Still closing at the end of the window: the window edge is a minimum
+    if(wholeWindow && samples > 1 && prev.rangeRate < 0.0f) addSampleApproach(row1, row2, samples - 1, true, out);
+}
+
+ConjunctionAnalyzer::RelativeSample ConjunctionAnalyzer::relativeSample(int row1, int row2, int step) const {
+    RelativeSample sample;
+    sample.dr = ephemeris.position(row1, step) - ephemeris.position(row2, step);
+    sample.dv = ephemeris.velocity(row1, step) - ephemeris.velocity(row2, step);
+    sample.rangeRate = glm::dot(sample.dr, sample.dv); // Sign of d|dr|/dt
+    return sample;
+}
+
+bool ConjunctionAnalyzer::bracketCanReach(int row1, int row2, int step,
+                                          const RelativeSample& a, const RelativeSample& b, float h) const {
+    // Lower bound on the separation inside [t_k, t_k+1]: every point is within
+    // h/2 of a sample, and the relative speed can grow by at most the summed
+    // gravitational accelerations of both objects.
+    float accel = MU / glm::dot(ephemeris.position(row1, step), ephemeris.position(row1, step))
+                + MU / glm::dot(ephemeris.position(row2, step), ephemeris.position(row2, step));
+    float speed = std::max(glm::length(a.dv), glm::length(b.dv));
+    float reach = 0.5f * h * speed + 0.125f * h * h * accel;
+    return std::min(glm::length(a.dr), glm::length(b.dr)) - reach < minDistanceThreshold;
+}
+
+double ConjunctionAnalyzer::refineBracket(const RelativeSample& a, const RelativeSample& b, float step) const {
+    // Range-rate of the cubic Hermite interpolant through both samples
+    glm::dvec3 dr0(a.dr), dv0(a.dv), dr1(b.dr), dv1(b.dv);
+    double h = step;
+    auto rangeRate = [&](double tau) {
+        double s = tau / h;
+        double s2 = s * s;
+        double s3 = s2 * s;
+        
+        glm::dvec3 dr = dr0 * (2.0 * s3 - 3.0 * s2 + 1.0)
+                      + dv0 * (h * (s3 - 2.0 * s2 + s))
+                      + dr1 * (-2.0 * s3 + 3.0 * s2)
+                      + dv1 * (h * (s3 - s2));
+        glm::dvec3 dv = dr0 * ((6.0 * s2 - 6.0 * s) / h)
+                      + dv0 * (3.0 * s2 - 4.0 * s + 1.0)
+                      + dr1 * ((-6.0 * s2 + 6.0 * s) / h)
+                      + dv1 * (3.0 * s2 - 2.0 * s);
+        return glm::dot(dr, dv);
+    };
+    
+    return brentRoot<double>(rangeRate, 0.0, h, (double)a.rangeRate, (double)b.rangeRate, (double)tcaTolerance);
+}
+
+void ConjunctionAnalyzer::addSampleApproach(int row1, int row2, int step, bool provisional,
+                                            std::vector<ClosestApproach>& out) const {
+    glm::vec3 pos1 = ephemeris.position(row1, step);
+    glm::vec3 pos2 = ephemeris.position(row2, step);
+    float dist = glm::distance(pos1, pos2);
+    if(dist >= minDistanceThreshold) return;
+    
+    ClosestApproach approach;
+    approach.time = ephemeris.getTime(step);
+    approach.distance = dist;
+    approach.position = (pos1 + pos2) * 0.5f;
+    approach.vel1 = ephemeris.velocity(row1, step);
+    approach.vel2 = ephemeris.velocity(row2, step);
+    approach.provisional = provisional;
+    out.push_back(approach);
 }
 
-float ConjunctionAnalyzer::calculateRiskScore(float distance, float relVel, float altitude) {
+float ConjunctionAnalyzer::calculateRiskScore(float distance, float relVel, float altitude) const {
     // Risk score formula (0-100):
     // - Distance: closer = higher risk
     // - Relative velocity: faster = higher risk
@@ -133,7 +384,7 @@ float ConjunctionAnalyzer::calculateRiskScore(float distance, float relVel, floa
     return std::min(distanceScore + velocityScore + altitudeScore, 100.0f);
 }
 
-RiskLevel ConjunctionAnalyzer::determineRiskLevel(float distance) {
+RiskLevel ConjunctionAnalyzer::determineRiskLevel(float distance) const {
     if(distance < 1.0f) return RiskLevel::CRITICAL;
     if(distance < 2.0f) return RiskLevel::HIGH;
     if(distance < 5.0f) return RiskLevel::MEDIUM;
@@ -141,7 +392,7 @@ RiskLevel ConjunctionAnalyzer::determineRiskLevel(float distance) {
     return RiskLevel::SAFE;
 }
 
-float ConjunctionAnalyzer::estimateCollisionEnergy(float relVel, float mass1, float mass2) {
+float ConjunctionAnalyzer::estimateCollisionEnergy(float relVel, float mass1, float mass2) const {
     // Kinetic energy: 0.5 * m * v^2
     // Use reduced mass for collision: m1*m2/(m1+m2)
     float reducedMass = (mass1 * mass2) / (mass1 + mass2);
@@ -149,7 +400,7 @@ float ConjunctionAnalyzer::estimateCollisionEnergy(float relVel, float mass1, fl
     return 0.5f * reducedMass * relVelMs * relVelMs; // Joules
 }
 
-void ConjunctionAnalyzer::clearOldEvents(float currentTime) {
+void ConjunctionAnalyzer::clearOldEvents(SimTime currentTime) {
     // Remove events that have passed
     events.erase(
         std::remove_if(events.begin(), events.end(),
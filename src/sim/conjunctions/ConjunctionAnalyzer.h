@@ -2,9 +2,15 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include <string>
+#include <utility>
+#include <memory>
+#include "EphemerisCache.h"
+#include "../SimTime.h"
+#include "../../util/ThreadPool.h"
 
 // Forward declaration
-struct Satellite;
+struct SatelliteStore;
+class SatelliteRef;
 
 enum class RiskLevel {
     SAFE = 0,      // > 10 km
@@ -17,7 +23,7 @@ enum class RiskLevel {
 struct ConjunctionEvent {
     int sat1_id;
     int sat2_id;
-    float tca_time;              // Time of Closest Approach (seconds from now)
+    SimTime tca_time;            // Time of Closest Approach (sim time)
     glm::vec3 tca_position;      // Position at TCA
     float min_distance;          // km
     float relative_velocity;     // km/s
@@ -25,6 +31,8 @@ struct ConjunctionEvent {
     float risk_score;            // 0-100
     RiskLevel risk_level;
     bool is_active;              // Still relevant
+    bool provisional;            // TCA clipped to the end of the screened window, re-screened when it advances
+    bool deep_space;             // An object is deep-space (near-Earth SGP4 only): km-per-day error, low confidence
     
     // For visualization
     glm::vec3 sat1_velocity_at_tca;
@@ -34,27 +42,53 @@ struct ConjunctionEvent {
 class ConjunctionAnalyzer {
 public:
     ConjunctionAnalyzer();
+    ~ConjunctionAnalyzer();
     
     // Main analysis function
     void analyzeFutureConjunctions(
-        const std::vector<Satellite>& satellites,
-        float currentTime,
+        const SatelliteStore& satellites,
+        SimTime currentTime,
         float predictionWindow = 3600.0f  // 1 hour default
     );
     
+    // Incremental variant for frequent calls: keeps previous results, screens only
+    // the slice newly exposed at the end of the window and drops passed events.
+    // Falls back to a full analysis on the first call, when satellites were added,
+    // or when time jumped past the screened window.
+    void updateFutureConjunctions(
+        const SatelliteStore& satellites,
+        SimTime currentTime,
+        float predictionWindow = 3600.0f
+    );
+    
+
     // Getters
     const std::vector<ConjunctionEvent>& getEvents() const { return events; }
     const std::vector<ConjunctionEvent>& getCriticalEvents() const { return criticalEvents; }
+    size_t getLastPrunedPairs() const { return lastPrunedPairs; } // Pairs skipped by the orbit band filter
     
     // Configuration
-    void setMinDistanceThreshold(float km) { minDistanceThreshold = km; }
+    void setMinDistanceThreshold(float km) { minDistanceThreshold = km; hasScreenedWindow = false; }
     void setRiskScoreThreshold(float score) { riskScoreThreshold = score; }
-    void setPredictionSteps(int steps) { predictionSteps = steps; }
+    void setPredictionSteps(int steps) { predictionSteps = steps; hasScreenedWindow = false; }
+    void setTcaTolerance(float seconds) { tcaTolerance = seconds; }
+    void setThreadCount(int count); // Worker threads for analysis (default: hardware concurrency)
+    int getThreadCount() const { return threadCount; }
     
     // Event management
-    void clearOldEvents(float currentTime);
+    void clearOldEvents(SimTime currentTime);
     ConjunctionEvent* getEventById(int sat1, int sat2);
     
+    // Incremental screening progress, saved with the events in checkpoints so a
+    // resumed run continues sliding the window instead of rescanning it
+    struct ScreeningState {
+        bool valid;                // A window has been screened
+        SimTime screenedUntil;
+        size_t satelliteCount;     // Catalog size at the last full analysis
+    };
+    ScreeningState getScreeningState() const { return {hasScreenedWindow, screenedUntil, screenedSatelliteCount}; }
+    void restoreState(const ConjunctionEvent* savedEvents, size_t count, const ScreeningState& screening);
+    
 private:
     std::vector<ConjunctionEvent> events;
     std::vector<ConjunctionEvent> criticalEvents; // Cache for high-risk events
@@ -62,27 +96,71 @@ private:
     // Thresholds
     float minDistanceThreshold;  // km
     float riskScoreThreshold;    // 0-100
-    int predictionSteps;         // Number of future time steps to check
+    int predictionSteps;         // Number of coarse steps used to bracket approaches
+    float tcaTolerance;          // TCA refinement tolerance (s)
+    
+    // Pair filtering (reused between runs)
+    std::vector<std::pair<int,int>> candidatePairs;
+    size_t lastPrunedPairs;
+    
+    // Shared samples of the window (or slice) being screened
+    EphemerisCache ephemeris;
+    
+    // Incremental screening state
+    bool hasScreenedWindow;
+    SimTime screenedUntil;        // End of the window covered by events
+    size_t screenedSatelliteCount; // Catalog size at the last full analysis
+    
+    // Parallel screening
+    struct IndexedEvent {
+        size_t pairIndex; // Position in candidatePairs, restores serial order on merge
+        ConjunctionEvent event;
+    };
+    int threadCount;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::vector<IndexedEvent>> threadEvents; // Per-thread buffers
+    
+    // Screen candidate pairs over [startTime, endTime] and append events in pair order.
+    // Returns the number of active pairs before band filtering.
+    size_t screenWindow(const SatelliteStore& satellites, SimTime startTime, SimTime endTime, int steps,
+                      bool includeStartEdge);
+    void rebuildCriticalEvents();
     
     // Helper functions
-    float calculateRiskScore(float distance, float relVel, float altitude);
-    RiskLevel determineRiskLevel(float distance);
-    float estimateCollisionEnergy(float relVel, float sat1Mass, float sat2Mass);
+    float calculateRiskScore(float distance, float relVel, float altitude) const;
+    RiskLevel determineRiskLevel(float distance) const;
+    float estimateCollisionEnergy(float relVel, float sat1Mass, float sat2Mass) const;
     
-    // Find closest approach between two orbital paths
+    // Close approach between two orbital paths
     struct ClosestApproach {
-        float time;
+        SimTime time;
         float distance;
         glm::vec3 position;
         glm::vec3 vel1;
         glm::vec3 vel2;
+        bool provisional; // Minimum at the end edge of the window
     };
-    ClosestApproach findClosestApproach(
-        const Satellite& sat1,
-        const Satellite& sat2,
-        float startTime,
-        float endTime,
-        int steps
-    );
+    ConjunctionEvent makeEvent(const SatelliteRef& sat1, const SatelliteRef& sat2, const ClosestApproach& approach) const;
+    
+    // All local minima below threshold in the window (rows in the ephemeris cache)
+    void findCloseApproaches(
+        const SatelliteRef& sat1,
+        const SatelliteRef& sat2,
+        int row1,
+        int row2,
+        bool includeStartEdge,
+        std::vector<ClosestApproach>& out
+    ) const;
+    
+    // Relative state of a pair at one cached sample
+    struct RelativeSample {
+        glm::vec3 dr;
+        glm::vec3 dv;
+        float rangeRate; // dr . dv
+    };
+    RelativeSample relativeSample(int row1, int row2, int step) const;
+    bool bracketCanReach(int row1, int row2, int step, const RelativeSample& a, const RelativeSample& b, float h) const;
+    double refineBracket(const RelativeSample& a, const RelativeSample& b, float h) const; // TCA offset in [0, h]
+    void addSampleApproach(int row1, int row2, int step, bool provisional, std::vector<ClosestApproach>& out) const;
 };
 
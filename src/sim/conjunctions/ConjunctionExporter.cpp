@@ -0,0 +1,277 @@
+#include "ConjunctionExporter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "../../util/Log.h"
+
+namespace {
+const char* const CSV_HEADER =
+    "analysis_time,sat1_id,sat2_id,tca_time,min_distance_km,relative_velocity_kms,risk_score,risk_level,deep_space\n";
+
+// Events buffered between the submitting threads and the writer
+const size_t QUEUE_CAPACITY = 65536;
+
+// Two results for the same pair count as one encounter while the TCA moves less than this
+const SimTime REPEAT_TCA_TOLERANCE = 60.0;
+
+// Idle writer re-checks the queue at least this often (a missed wakeup costs at most this)
+const auto WRITER_POLL = std::chrono::milliseconds(50);
+
+const char* RiskName(RiskLevel level) {
+    switch(level) {
+        case RiskLevel::SAFE: return "SAFE";
+        case RiskLevel::LOW: return "LOW";
+        case RiskLevel::MEDIUM: return "MEDIUM";
+        case RiskLevel::HIGH: return "HIGH";
+        case RiskLevel::CRITICAL: return "CRITICAL";
+    }
+    return "UNKNOWN";
+}
+
+uint64_t PairKey(int a, int b) {
+    return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+}
+
+ConjunctionExporter::ConjunctionExporter() {
+}
+
+ConjunctionExporter::~ConjunctionExporter() {
+    stop();
+}
+
+bool ConjunctionExporter::ParseFormat(const std::string& name, Format& out) {
+    if(name == "csv") out = Format::CSV;
+    else if(name == "jsonl" || name == "json") out = Format::JSON_LINES;
+    else if(name == "cdm") out = Format::CDM;
+    else return false;
+    return true;
+}
+
+bool ConjunctionExporter::start(const std::string& path, Format fmt) {
+    stop();
+    
+    basePath = path;
+    format = fmt;
+    fileIndex = 0;
+    messageCount = 0;
+    writtenTca.clear();
+    prunedAt = 0.0;
+    if(!openFile(0)) return false;
+    
+    queue = std::make_unique<BoundedQueue<Record>>(QUEUE_CAPACITY);
+    stopping = false;
+    writer = std::thread(&ConjunctionExporter::writerLoop, this);
+    return true;
+}
+
+void ConjunctionExporter::stop() {
+    if(!writer.joinable()) return;
+    stopping = true;
+    wakeCondition.notify_one();
+    writer.join(); // The writer drains the queue before it exits
+    closeFile();
+    
+    if(droppedCount > 0) {
+        LOG_WARN("Conjunction export: " << droppedCount << " events dropped (writer queue full)");
+    }
+}
+
+size_t ConjunctionExporter::submit(SimTime analysisTime, const std::vector<ConjunctionEvent>& events) {
+    if(!queue) return 0;
+    
+    size_t queued = 0;
+    for(const auto& ev : events) {
+        Record r;
+        r.analysisTime = analysisTime;
+        r.tcaTime = ev.tca_time;
+        r.sat1 = ev.sat1_id;
+        r.sat2 = ev.sat2_id;
+        r.minDistance = ev.min_distance;
+        r.relativeVelocity = ev.relative_velocity;
+        r.riskScore = ev.risk_score;
+        r.riskLevel = ev.risk_level;
+        r.provisional = ev.provisional;
+        r.deepSpace = ev.deep_space;
+        
+        bool pushed = queue->tryPush(r);
+        while(!pushed && overflow == Overflow::WAIT) {
+            wakeCondition.notify_one();
+            std::this_thread::yield();
+            pushed = queue->tryPush(r);
+        }
+        if(pushed) queued++;
+        else droppedCount++;
+    }
+    if(queued > 0) wakeCondition.notify_one(); // No lock taken: a missed wakeup only delays the writer
+    return queued;
+}
+
+void ConjunctionExporter::writerLoop() {
+    Record r;
+    for(;;) {
+        size_t batch = 0;
+        while(queue->tryPop(r)) {
+            writeRecord(r);
+            batch++;
+        }
+        // Hand the batch to the OS only once the queue runs dry
+        bool wrote = batch > 0;
+        if(wrote) file.flush();
+        
+        if(stopping && queue->empty()) break;
+        if(!wrote) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, WRITER_POLL);
+        }
+    }
+}
+
+bool ConjunctionExporter::isRepeat(const Record& r) {
+    if(r.analysisTime > prunedAt) pruneWritten(r.analysisTime); // Once per analysis
+    
+    std::vector<SimTime>& tcas = writtenTca[PairKey(r.sat1, r.sat2)];
+    for(SimTime& tca : tcas) {
+        if(std::abs(r.tcaTime - tca) < REPEAT_TCA_TOLERANCE) {
+            tca = r.tcaTime; // Follow refinements of the same encounter
+            return true;
+        }
+    }
+    tcas.push_back(r.tcaTime);
+    return false;
+}
+
+void ConjunctionExporter::pruneWritten(SimTime now) {
+    prunedAt = now;
+    for(auto it = writtenTca.begin(); it != writtenTca.end(); ) {
+        std::vector<SimTime>& tcas = it->second;
+        tcas.erase(std::remove_if(tcas.begin(), tcas.end(),
+                                  [&](SimTime tca) { return tca < now - REPEAT_TCA_TOLERANCE; }),
+                   tcas.end());
+        if(tcas.empty()) it = writtenTca.erase(it);
+        else ++it;
+    }
+}
+
+void ConjunctionExporter::writeRecord(const Record& r) {
+    if(onlyChanges && isRepeat(r)) return;
+    
+    formatRecord(r);
+    if(maxFileBytes > 0 && fileBytes > 0 && fileBytes + line.size() > maxFileBytes) {
+        closeFile();
+        openFile(fileIndex + 1);
+    }
+    if(file.is_open()) {
+        file.write(line.data(), line.size());
+        fileBytes += line.size();
+        writtenCount++;
+    }
+}
+
+std::string ConjunctionExporter::filePath(int index) const {
+    if(maxFileBytes == 0) return basePath;
+    
+    // <stem>.0000<ext>
+    size_t slash = basePath.find_last_of("/\\");
+    size_t dot = basePath.find_last_of('.');
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = basePath.size();
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%04d", index);
+    return basePath.substr(0, dot) + suffix + basePath.substr(dot);
+}
+
+bool ConjunctionExporter::openFile(int index) {
+    fileIndex = index;
+    file.open(filePath(index), std::ios::out | std::ios::trunc | std::ios::binary);
+    if(!file.is_open()) {
+        LOG_ERROR("Failed to open conjunction export file: " << filePath(index));
+        return false;
+    }
+    fileBytes = 0;
+    if(format == Format::CSV) {
+        file << CSV_HEADER;
+        fileBytes = strlen(CSV_HEADER);
+    }
+    return true;
+}
+
+void ConjunctionExporter::closeFile() {
+    if(file.is_open()) file.close();
+}
+
+std::string ConjunctionExporter::formatDate(SimTime t) const {
+    // Julian date to Gregorian calendar (Meeus, ch. 7), millisecond resolution
+    double jd = scenarioEpochJd + t / 86400.0 + 0.5;
+    double z = std::floor(jd);
+    double dayFraction = jd - z;
+    double alpha = std::floor((z - 1867216.25) / 36524.25);
+    double a = z + 1 + alpha - std::floor(alpha / 4);
+    double b = a + 1524;
+    double c = std::floor((b - 122.1) / 365.25);
+    double d = std::floor(365.25 * c);
+    double e = std::floor((b - d) / 30.6001);
+    int day = (int)(b - d - std::floor(30.6001 * e));
+    int month = (int)(e < 14 ? e - 1 : e - 13);
+    int year = (int)(month > 2 ? c - 4716 : c - 4715);
+    
+    long long ms = std::llround(dayFraction * 86400000.0);
+    if(ms >= 86400000LL) ms = 86399999LL; // Rounding never carries into the next day
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02lld:%02lld:%02lld.%03lld", year, month, day,
+             ms / 3600000, (ms / 60000) % 60, (ms / 1000) % 60, ms % 1000);
+    return buf;
+}
+
+void ConjunctionExporter::formatRecord(const Record& r) {
+    char buf[512];
+    int n = 0;
+    switch(format) {
+        case Format::CSV:
+            // %.10g: the headless tool's precision, sim times past ~11 days need it
+            n = snprintf(buf, sizeof(buf), "%.10g,%d,%d,%.10g,%.10g,%.10g,%.10g,%d,%d\n",
+                         r.analysisTime, r.sat1, r.sat2, r.tcaTime, (double)r.minDistance,
+                         (double)r.relativeVelocity, (double)r.riskScore, (int)r.riskLevel, r.deepSpace ? 1 : 0);
+            line.assign(buf, n);
+            break;
+        
+        case Format::JSON_LINES:
+            n = snprintf(buf, sizeof(buf),
+                         "{\"analysis_time\":%.10g,\"sat1_id\":%d,\"sat2_id\":%d,\"tca_time\":%.10g,"
+                         "\"min_distance_km\":%.10g,\"relative_velocity_kms\":%.10g,\"risk_score\":%.10g,"
+                         "\"risk_level\":\"%s\",\"provisional\":%s,\"deep_space\":%s}\n",
+                         r.analysisTime, r.sat1, r.sat2, r.tcaTime, (double)r.minDistance,
+                         (double)r.relativeVelocity, (double)r.riskScore, RiskName(r.riskLevel),
+                         r.provisional ? "true" : "false", r.deepSpace ? "true" : "false");
+            line.assign(buf, n);
+            break;
+        
+        case Format::CDM:
+            // KVN keywords of CCSDS 508.0 that the analyzer can fill; one block per event
+            // Without a scenario epoch there is no UTC to give: the dated
+            // keywords are left out rather than made up
+            line = "CCSDS_CDM_VERS = 1.0\n";
+            if(scenarioEpochJd > 0.0) line += "CREATION_DATE = " + formatDate(r.analysisTime) + "\n";
+            line += "ORIGINATOR = SATSIM\n";
+            n = snprintf(buf, sizeof(buf),
+                         "MESSAGE_ID = SATSIM-%zu\n"
+                         "COMMENT Sim time of TCA %.3f s, risk score %.1f (%s)%s\n",
+                         messageCount++, r.tcaTime, (double)r.riskScore, RiskName(r.riskLevel),
+                         r.provisional ? ", provisional" : "");
+            line.append(buf, n);
+            if(r.deepSpace) line += "COMMENT Low confidence: deep-space object propagated without SDP4 terms\n";
+            if(scenarioEpochJd > 0.0) line += "TCA = " + formatDate(r.tcaTime) + "\n";
+            else line += "COMMENT No scenario epoch: times are seconds of sim time\n";
+            n = snprintf(buf, sizeof(buf),
+                         "MISS_DISTANCE = %.3f [m]\n"
+                         "RELATIVE_SPEED = %.3f [m/s]\n"
+                         "OBJECT = OBJECT1\n"
+                         "OBJECT_DESIGNATOR = %d\n"
+                         "OBJECT = OBJECT2\n"
+                         "OBJECT_DESIGNATOR = %d\n\n",
+                         r.minDistance * 1000.0, r.relativeVelocity * 1000.0, r.sat1, r.sat2);
+            line.append(buf, n);
+            break;
+    }
+}
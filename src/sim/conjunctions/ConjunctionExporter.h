@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ConjunctionAnalyzer.h"
+#include "../../util/BoundedQueue.h"
+
+// Persists conjunction events on a background writer thread. submit() only
+// copies events into a bounded lock-free queue, so the analysis and render
+// threads never wait on disk I/O; serialization, file rotation and flushing
+// all happen on the writer.
+class ConjunctionExporter {
+public:
+    enum class Format {
+        CSV,          // One row per event, same columns as the headless output
+        JSON_LINES,   // One JSON object per event
+        CDM           // CCSDS Conjunction Data Message style KVN blocks
+    };
+    
+    // What submit() does when the queue is full
+    enum class Overflow {
+        DROP,         // Discard and count (interactive app: never stall a frame)
+        WAIT          // Yield until the writer catches up (batch runs: keep every row)
+    };
+    
+    ConjunctionExporter();
+    ~ConjunctionExporter(); // Writes out everything queued, then stops
+    
+    ConjunctionExporter(const ConjunctionExporter&) = delete;
+    ConjunctionExporter& operator=(const ConjunctionExporter&) = delete;
+    
+    // Configuration, before start()
+    void setMaxFileBytes(size_t bytes) { maxFileBytes = bytes; }   // 0: one file, no rotation
+    void setOnlyChanges(bool enable) { onlyChanges = enable; }    // Skip repeats of an already written encounter
+    void setOverflow(Overflow policy) { overflow = policy; }
+    // UTC Julian date of sim time 0, for CDM dates. 0 (unknown, e.g. a Keplerian
+    // JSON catalog): CDM blocks carry sim-relative times only.
+    void setScenarioEpochJd(double jd) { scenarioEpochJd = jd; }
+    
+    // Opens the first file and starts the writer. With rotation enabled the
+    // files are named <stem>.0000<ext>, <stem>.0001<ext>, ...
+    bool start(const std::string& path, Format format);
+    void stop();
+    bool isRunning() const { return writer.joinable(); }
+    
+    // Queues one analysis worth of events. Never touches the disk. Returns
+    // the number of events queued.
+    size_t submit(SimTime analysisTime, const std::vector<ConjunctionEvent>& events);
+    
+    size_t getWrittenCount() const { return writtenCount.load(); }
+    size_t getDroppedCount() const { return droppedCount.load(); }
+    int getFileCount() const { return fileIndex.load() + 1; }
+    
+    // "csv", "jsonl" / "json", "cdm"
+    static bool ParseFormat(const std::string& name, Format& format);
+
+private:
+    // Compact copy of the exported fields, trivially copyable for the queue
+    struct Record {
+        SimTime analysisTime;
+        SimTime tcaTime;
+        int sat1;
+        int sat2;
+        float minDistance;       // km
+        float relativeVelocity;  // km/s
+        float riskScore;
+        RiskLevel riskLevel;
+        bool provisional;
+        bool deepSpace;
+    };
+    
+    // Settings
+    size_t maxFileBytes = 0;
+    bool onlyChanges = false;
+    Overflow overflow = Overflow::DROP;
+    double scenarioEpochJd = 0.0;
+    
+    std::string basePath;
+    Format format = Format::CSV;
+    std::unique_ptr<BoundedQueue<Record>> queue;
+    
+    // Writer thread
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> writtenCount{0};
+    std::atomic<size_t> droppedCount{0};
+    std::atomic<int> fileIndex{0};
+    
+    // Writer-owned state
+    std::ofstream file;
+    size_t fileBytes = 0;
+    size_t messageCount = 0;
+    std::string line;
+    // Written encounters for onlyChanges: every TCA of a pair, since one
+    // window can hold several approaches. Pruned once a TCA has passed.
+    std::unordered_map<uint64_t, std::vector<SimTime>> writtenTca;
+    SimTime prunedAt = 0.0;
+    
+    void writerLoop();
+    void writeRecord(const Record& r);
+    bool isRepeat(const Record& r);
+    void pruneWritten(SimTime now);
+    bool openFile(int index);
+    void closeFile();
+    std::string filePath(int index) const;
+    void formatRecord(const Record& r);
+    std::string formatDate(SimTime t) const;
+};
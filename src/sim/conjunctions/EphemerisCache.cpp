@@ -0,0 +1,53 @@
+#include "EphemerisCache.h"
+#include "../OrbitPropagator.h"
+#include "../SatelliteStore.h"
+#include "../../util/ThreadPool.h"
+#include <cmath>
+
+void EphemerisCache::build(const SatelliteStore& satellites, SimTime start, SimTime endTime, int steps,
+                           ThreadPool* pool) {
+    startTime = start;
+    dt = (endTime - start) / steps;
+    sampleCount = steps + 1;
+    
+    rows.assign(satellites.size(), -1);
+    elements.clear();
+    elements.reserve(satellites.activeCount());
+    int rowCount = 0;
+    satellites.active.forEach([&](size_t i) {
+        rows[i] = rowCount++;
+        elements.add(satellites.orbits[i], satellites.sgp4[i]);
+    });
+    elements.rebase(start); // Sample times become small offsets for the float kernel
+    
+    size_t total = (size_t)rowCount * sampleCount;
+    x.resize(total); y.resize(total); z.resize(total);
+    vx.resize(total); vy.resize(total); vz.resize(total);
+    
+    // Propagate all rows to one sample time, then scatter into the per-row layout
+    stepStates.resize(pool ? pool->getThreadCount() : 1);
+    auto fillSteps = [&](size_t begin, size_t end, int worker) {
+        StateSoA& state = stepStates[worker];
+        for(size_t k = begin; k < end; ++k) {
+            OrbitPropagator::PropagateBatch(elements, getTime((int)k), state);
+            
+            for(int row = 0; row < rowCount; ++row) {
+                size_t idx = (size_t)row * sampleCount + k;
+                x[idx] = state.x[row]; y[idx] = state.y[row]; z[idx] = state.z[row];
+                vx[idx] = state.vx[row]; vy[idx] = state.vy[row]; vz[idx] = state.vz[row];
+            }
+        }
+    };
+    
+    if(pool) pool->parallelFor(sampleCount, 1, fillSteps);
+    else fillSteps(0, sampleCount, 0);
+    
+    // Only SGP4 rows can fail; an object stays invalid once it has decayed
+    validSamples.assign(rowCount, sampleCount);
+    for(size_t row : elements.sgp4Index) {
+        const float* rowX = &x[row * sampleCount];
+        int valid = 0;
+        while(valid < sampleCount && !std::isnan(rowX[valid])) valid++;
+        validSamples[row] = valid;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "../OrbitPropagator.h"
+
+struct SatelliteStore;
+class ThreadPool;
+
+// Position/velocity of every active satellite sampled on a uniform time grid
+// over the prediction window. All satellites are batch-propagated once per sample,
+// and pair evaluation only reads from the table, so an analysis run costs
+// O(N * steps) Kepler solves instead of O(N^2 * steps).
+//
+// Storage is structure-of-arrays, one contiguous row of samples per satellite:
+// x[row * sampleCount + step].
+class EphemerisCache {
+public:
+    // Time steps are propagated in parallel when a pool is given
+    void build(const SatelliteStore& satellites, SimTime startTime, SimTime endTime, int steps,
+               ThreadPool* pool = nullptr);
+    
+    int getSampleCount() const { return sampleCount; }
+    SimTime getTime(int step) const { return startTime + step * dt; }
+    float getStepSize() const { return (float)dt; }
+    
+    // Row of a satellite (slot in the store passed to build), -1 if inactive
+    int rowOf(int satIndex) const { return rows[satIndex]; }
+    
+    // Leading samples of a row with a valid state: a TLE object that decays
+    // inside the window has NaN samples from the first failed SGP4 call on
+    int getValidSampleCount(int row) const { return validSamples[row]; }
+    
+    glm::vec3 position(int row, int step) const {
+        size_t k = (size_t)row * sampleCount + step;
+        return glm::vec3(x[k], y[k], z[k]);
+    }
+    glm::vec3 velocity(int row, int step) const {
+        size_t k = (size_t)row * sampleCount + step;
+        return glm::vec3(vx[k], vy[k], vz[k]);
+    }
+    
+private:
+    int sampleCount = 0;
+    SimTime startTime = 0.0;
+    SimTime dt = 0.0;
+    
+    std::vector<int> rows;
+    std::vector<int> validSamples;
+    std::vector<float> x, y, z;
+    std::vector<float> vx, vy, vz;
+    
+    // Batch propagation input/output (one state buffer per worker)
+    ElementsSoA elements;
+    std::vector<StateSoA> stepStates;
+};
@@ -0,0 +1,74 @@
+#include "OrbitBandFilter.h"
+#include "EphemerisCache.h"
+#include "../SatelliteStore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+struct RadialBand {
+    float low;   // Perigee radius - padding (km)
+    float high;  // Apogee radius + padding (km)
+    int index;
+};
+
+// Radius range of an ephemeris row, widened by the largest change between
+// consecutive samples so extremes that fall between samples are covered
+void SampledRadiusRange(const EphemerisCache& ephemeris, int row, float& low, float& high) {
+    float previous = glm::length(ephemeris.position(row, 0));
+    float maxChange = 0.0f;
+    low = high = previous;
+    for(int step = 1; step < ephemeris.getValidSampleCount(row); ++step) {
+        float r = glm::length(ephemeris.position(row, step));
+        low = std::min(low, r);
+        high = std::max(high, r);
+        maxChange = std::max(maxChange, std::fabs(r - previous));
+        previous = r;
+    }
+    low -= maxChange;
+    high += maxChange;
+}
+}
+
+size_t OrbitBandFilter::BuildCandidatePairs(
+    const SatelliteStore& satellites,
+    const EphemerisCache& ephemeris,
+    float padding,
+    std::vector<std::pair<int,int>>& pairs)
+{
+    pairs.clear();
+    
+    std::vector<RadialBand> bands;
+    bands.reserve(satellites.activeCount());
+    const float* sma = satellites.elements.semiMajorAxis.data();
+    const float* ecc = satellites.elements.eccentricity.data();
+    satellites.active.forEach([&](size_t i) {
+        float perigee = sma[i] * (1.0f - ecc[i]);
+        float apogee = sma[i] * (1.0f + ecc[i]);
+        int row = ephemeris.rowOf((int)i);
+        if(satellites.sgp4[i] && row >= 0) {
+            if(ephemeris.getValidSampleCount(row) == 0) return; // Already decayed: nothing to screen
+            SampledRadiusRange(ephemeris, row, perigee, apogee);
+        }
+        bands.push_back({perigee - padding, apogee + padding, (int)i});
+    });
+    
+    std::sort(bands.begin(), bands.end(), [](const RadialBand& a, const RadialBand& b) {
+        return a.low < b.low;
+    });
+    
+    // Sweep by increasing perigee: every later band that starts before the
+    // current one ends overlaps it
+    for(size_t a = 0; a < bands.size(); ++a) {
+        for(size_t b = a + 1; b < bands.size() && bands[b].low <= bands[a].high; ++b) {
+            int i = bands[a].index;
+            int j = bands[b].index;
+            pairs.push_back(i < j ? std::make_pair(i, j) : std::make_pair(j, i));
+        }
+    }
+    
+    // Keep the same pair order as the plain nested loop
+    std::sort(pairs.begin(), pairs.end());
+    
+    size_t n = bands.size();
+    return n < 2 ? 0 : n * (n - 1) / 2;
+}
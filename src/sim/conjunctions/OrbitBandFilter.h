@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+struct SatelliteStore;
+class EphemerisCache;
+
+// Radial pre-filter for conjunction screening. Two objects can never come
+// closer than the gap between their [perigee, apogee] radius bands, so pairs
+// whose padded bands do not overlap (LEO vs GEO, ...) are dropped before any
+// pair is evaluated.
+//
+// Two-body bands come from the elements and are exact. SGP4 objects are not
+// bound by their mean-element band: short-period J2 terms and drag move the
+// real radius several km outside it (10 km in sun-synchronous LEO). Their
+// band is the radius range sampled in the ephemeris of the screened window,
+// widened by the largest radius change between two samples, so the filter
+// stays conservative for them too.
+class OrbitBandFilter {
+public:
+    // Writes (i, j) index pairs, i < j, sorted in catalog order, for active
+    // satellites whose bands overlap after padding each by `padding` km.
+    // `ephemeris` must be built for the window being screened.
+    // Returns the number of active pairs that were considered.
+    static size_t BuildCandidatePairs(
+        const SatelliteStore& satellites,
+        const EphemerisCache& ephemeris,
+        float padding,
+        std::vector<std::pair<int,int>>& pairs
+    );
+};
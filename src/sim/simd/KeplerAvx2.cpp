@@ -0,0 +1,36 @@
+// Compiled with -mavx2 -mfma; only reached after a runtime CPU check
+#include "KeplerKernel.h"
+#include <immintrin.h>
+
+namespace {
+struct Avx2Ops {
+    using Vec = __m256;
+    static const size_t WIDTH = 8;
+    
+    static Vec set(float v) { return _mm256_set1_ps(v); }
+    static Vec sqrt(Vec v) { return _mm256_sqrt_ps(v); }
+    static Vec round(Vec v) { return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Vec floor(Vec v) { return _mm256_floor_ps(v); }
+    
+    // a > b ? x : y
+    static Vec selectGreater(Vec a, Vec b, Vec x, Vec y) {
+        return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+    }
+    
+    static __m256i laneMask(size_t lanes) {
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)lanes), index);
+    }
+    static Vec load(const float* p, size_t lanes) {
+        return lanes == WIDTH ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, laneMask(lanes));
+    }
+    static void store(float* p, Vec v, size_t lanes) {
+        if(lanes == WIDTH) _mm256_storeu_ps(p, v);
+        else _mm256_maskstore_ps(p, laneMask(lanes), v);
+    }
+};
+}
+
+void KeplerBatchAvx2(const KeplerBatchArgs& args) {
+    KeplerBatch<Avx2Ops>(args);
+}
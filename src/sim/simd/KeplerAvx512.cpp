@@ -0,0 +1,33 @@
+// Compiled with -mavx512f; only reached after a runtime CPU check
+#include "KeplerKernel.h"
+#include <immintrin.h>
+
+namespace {
+struct Avx512Ops {
+    using Vec = __m512;
+    static const size_t WIDTH = 16;
+    
+    static Vec set(float v) { return _mm512_set1_ps(v); }
+    static Vec sqrt(Vec v) { return _mm512_sqrt_ps(v); }
+    static Vec round(Vec v) { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Vec floor(Vec v) { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    
+    // a > b ? x : y
+    static Vec selectGreater(Vec a, Vec b, Vec x, Vec y) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), y, x);
+    }
+    
+    static __mmask16 laneMask(size_t lanes) { return (__mmask16)((1u << lanes) - 1u); }
+    static Vec load(const float* p, size_t lanes) {
+        return lanes == WIDTH ? _mm512_loadu_ps(p) : _mm512_maskz_loadu_ps(laneMask(lanes), p);
+    }
+    static void store(float* p, Vec v, size_t lanes) {
+        if(lanes == WIDTH) _mm512_storeu_ps(p, v);
+        else _mm512_mask_storeu_ps(p, laneMask(lanes), v);
+    }
+};
+}
+
+void KeplerBatchAvx512(const KeplerBatchArgs& args) {
+    KeplerBatch<Avx512Ops>(args);
+}
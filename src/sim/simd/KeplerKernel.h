@@ -0,0 +1,123 @@
+#pragma once
+#include <cstddef>
+
+// Branch-free two-body propagation kernel shared by the scalar, AVX2 and
+// AVX-512 batch paths. Each ISA translation unit supplies an `Ops` struct
+// (vector type, width, load/store and math primitives) and instantiates
+// KeplerBatch<Ops>. Keep this header free of standard-library calls: it is
+// compiled with ISA-specific flags, and inline library code emitted there
+// could be picked by the linker for the baseline build.
+
+// Raw views of ElementsSoA/StateSoA (see OrbitPropagator.h)
+struct KeplerBatchArgs {
+    size_t count;
+    const float* semiMajorAxis;
+    const float* eccentricity;
+    const float* meanMotion;     // rad/s
+    const float* meanAnomaly;    // M0 at epoch (rad)
+    const float* sqrtOneMinusE2; // sqrt(1 - e^2)
+    const float* px; const float* py; const float* pz; // Perifocal P axis (render frame)
+    const float* qx; const float* qy; const float* qz; // Perifocal Q axis (render frame)
+    
+    const float* times; // Per-object times, or nullptr to use `time` for all
+    float time;
+    
+    float* x; float* y; float* z;
+    float* vx; float* vy; float* vz;
+};
+
+namespace KeplerConst {
+const float MU = 398600.4418f; // Earth gravitational parameter km^3/s^2
+const float TWO_PI = 6.28318530717958647692f;
+const float INV_TWO_PI = 0.15915494309189533577f;
+const float TWO_OVER_PI = 0.63661977236758134308f;
+// pi/2 split in three parts for exact range reduction (Cody-Waite)
+const float PIO2_1 = 1.5703125f;
+const float PIO2_2 = 4.837512969970703125e-4f;
+const float PIO2_3 = 7.54978995489188216e-8f;
+const int NEWTON_ITERATIONS = 5;
+}
+
+// sin/cos of x with |x| up to a few thousand rad. Minimax polynomials on
+// [-pi/4, pi/4] (Cephes sinf/cosf), quadrant selection done with blends.
+template<class Ops>
+inline void KeplerSinCos(typename Ops::Vec x, typename Ops::Vec& s, typename Ops::Vec& c) {
+    using V = typename Ops::Vec;
+    using namespace KeplerConst;
+    
+    V q = Ops::round(x * Ops::set(TWO_OVER_PI));
+    V r = x - q * Ops::set(PIO2_1);
+    r = r - q * Ops::set(PIO2_2);
+    r = r - q * Ops::set(PIO2_3);
+    V r2 = r * r;
+    
+    V sp = r + r * r2 * (Ops::set(-1.6666654611e-1f) + r2 * (Ops::set(8.3321608736e-3f) + r2 * Ops::set(-1.9515295891e-4f)));
+    V cp = Ops::set(1.0f) - Ops::set(0.5f) * r2
+         + r2 * r2 * (Ops::set(4.166664568298827e-2f) + r2 * (Ops::set(-1.388731625493765e-3f) + r2 * Ops::set(2.443315711809948e-5f)));
+    
+    // Quadrant 0..3 and its parity, all in float arithmetic
+    V quadrant = q - Ops::set(4.0f) * Ops::floor(q * Ops::set(0.25f));
+    V odd = quadrant - Ops::set(2.0f) * Ops::floor(quadrant * Ops::set(0.5f));
+    V cosQuadrant = quadrant + Ops::set(1.0f);
+    cosQuadrant = cosQuadrant - Ops::set(4.0f) * Ops::floor(cosQuadrant * Ops::set(0.25f));
+    
+    V sv = Ops::selectGreater(odd, Ops::set(0.5f), cp, sp);
+    V cv = Ops::selectGreater(odd, Ops::set(0.5f), sp, cp);
+    s = Ops::selectGreater(quadrant, Ops::set(1.5f), -sv, sv);
+    c = Ops::selectGreater(cosQuadrant, Ops::set(1.5f), -cv, cv);
+}
+
+template<class Ops>
+inline void KeplerBatch(const KeplerBatchArgs& args) {
+    using V = typename Ops::Vec;
+    using namespace KeplerConst;
+    
+    for(size_t i = 0; i < args.count; i += Ops::WIDTH) {
+        size_t lanes = (args.count - i < Ops::WIDTH) ? args.count - i : Ops::WIDTH;
+        
+        V a   = Ops::load(args.semiMajorAxis + i, lanes);
+        V e   = Ops::load(args.eccentricity + i, lanes);
+        V n   = Ops::load(args.meanMotion + i, lanes);
+        V m0  = Ops::load(args.meanAnomaly + i, lanes);
+        V b   = Ops::load(args.sqrtOneMinusE2 + i, lanes);
+        V t   = args.times ? Ops::load(args.times + i, lanes) : Ops::set(args.time);
+        
+        // Mean anomaly wrapped to [-pi, pi]
+        V M = m0 + n * t;
+        M = M - Ops::set(TWO_PI) * Ops::round(M * Ops::set(INV_TWO_PI));
+        
+        // Kepler's equation M = E - e sin E: Newton-Raphson with Danby's starter
+        V sE, cE;
+        KeplerSinCos<Ops>(M, sE, cE);
+        V E = M + Ops::selectGreater(sE, Ops::set(0.0f), Ops::set(0.85f) * e, Ops::set(-0.85f) * e);
+        for(int k = 0; k < NEWTON_ITERATIONS; ++k) {
+            KeplerSinCos<Ops>(E, sE, cE);
+            V f = E - e * sE - M;
+            V fp = Ops::set(1.0f) - e * cE;
+            E = E - f / fp;
+        }
+        KeplerSinCos<Ops>(E, sE, cE);
+        
+        // Perifocal position and velocity
+        V r = a * (Ops::set(1.0f) - e * cE);
+        V xo = a * (cE - e);
+        V yo = a * b * sE;
+        V vfac = Ops::sqrt(Ops::set(MU) * a) / r;
+        V vxo = -vfac * sE;
+        V vyo = vfac * b * cE;
+        
+        V px = Ops::load(args.px + i, lanes), py = Ops::load(args.py + i, lanes), pz = Ops::load(args.pz + i, lanes);
+        V qx = Ops::load(args.qx + i, lanes), qy = Ops::load(args.qy + i, lanes), qz = Ops::load(args.qz + i, lanes);
+        
+        Ops::store(args.x + i, xo * px + yo * qx, lanes);
+        Ops::store(args.y + i, xo * py + yo * qy, lanes);
+        Ops::store(args.z + i, xo * pz + yo * qz, lanes);
+        Ops::store(args.vx + i, vxo * px + vyo * qx, lanes);
+        Ops::store(args.vy + i, vxo * py + vyo * qy, lanes);
+        Ops::store(args.vz + i, vxo * pz + vyo * qz, lanes);
+    }
+}
+
+// ISA entry points (compiled only when SATSIM_HAVE_AVX2 / SATSIM_HAVE_AVX512)
+void KeplerBatchAvx2(const KeplerBatchArgs& args);
+void KeplerBatchAvx512(const KeplerBatchArgs& args);
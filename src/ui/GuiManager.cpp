@@ -98,7 +98,7 @@ void GuiManager::Render(const SimState& state, const SatelliteSystem& sats, cons
     }
     ImGui::SameLine();
     if (ImGui::Button("⏹ STOP", ImVec2(80, 30))) {
-        *state.simTime = 0.0f;
+        *state.simTime = 0.0;
         *state.paused = true;
     }
     
@@ -126,11 +126,8 @@ void GuiManager::Render(const SimState& state, const SatelliteSystem& sats, cons
     ImGui::Spacing();
     ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "ℹ SATELLITES");
     ImGui::Separator();
-    int activeCount = 0;
+    int activeCount = (int)sats.getActiveCount();
     int totalCount = sats.getSatellites().size();
-    for(const auto& s : sats.getSatellites()) {
-        if(s.active) activeCount++;
-    }
     ImGui::Text("Active: %d / %d", activeCount, totalCount);
     ImGui::Text("Destroyed: %d", totalCount - activeCount);
     
@@ -173,6 +170,7 @@ void GuiManager::Render(const SimState& state, const SatelliteSystem& sats, cons
             ImGui::Text("Miss Dist: %.2f km", event.min_distance);
             ImGui::Text("Rel Vel: %.2f km/s", event.relative_velocity);
             ImGui::Text("Risk Score: %.0f", event.risk_score);
+            if(event.deep_space) ImGui::TextDisabled("Low confidence: deep-space object");
             
             // Energy bar
             float energyNormalized = std::min(event.collision_energy / 1e8f, 1.0f);
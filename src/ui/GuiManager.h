@@ -8,7 +8,7 @@
 class ConjunctionAnalyzer;
 
 struct SimState {
-    float* simTime;
+    SimTime* simTime;
     float* timeScale;
     bool* paused;
     int* selectedSatId;
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Allocator returning cache-line aligned storage, so the hot structure-of-arrays
+// buffers start on a 64-byte boundary (one AVX-512 vector, two AVX2 vectors)
+// and no vector load of a full lane group straddles a cache line.
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+    
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+    
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+    
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
@@ -0,0 +1,214 @@
+#include "BinaryCatalog.h"
+#include "MappedFile.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+static_assert(sizeof(CatalogHeader) == 88, "CatalogHeader layout is part of the file format");
+static_assert(sizeof(CatalogRecord) == 56, "CatalogRecord layout is part of the file format");
+static_assert(sizeof(CatalogIdEntry) == 8, "CatalogIdEntry layout is part of the file format");
+static_assert(std::is_trivially_copyable<Sgp4Record>::value, "Sgp4Record is stored byte-for-byte");
+
+namespace {
+const char CATALOG_MAGIC[8] = {'S', 'A', 'T', 'C', 'A', 'T', 0, 0};
+
+uint64_t AlignUp(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+}
+
+bool BinaryCatalog::open(const std::string& filepath) {
+    close();
+    
+    auto file = std::make_shared<MappedFile>();
+    if(!file->open(filepath)) {
+        LOG_ERROR("Failed to open binary catalog: " << filepath);
+        return false;
+    }
+    if(file->size() < sizeof(CatalogHeader)) {
+        LOG_ERROR("Binary catalog too small: " << filepath);
+        return false;
+    }
+    
+    const char* base = file->begin();
+    size_t length = file->size();
+    const CatalogHeader* h = reinterpret_cast<const CatalogHeader*>(base);
+    
+    // Validate before exposing anything
+    const char* error = nullptr;
+    if(memcmp(h->magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0) error = "not a satellite catalog";
+    else if(h->version != CATALOG_VERSION) error = "unsupported catalog version";
+    else if(h->headerSize != sizeof(CatalogHeader) || h->recordSize != sizeof(CatalogRecord))
+        error = "record layout mismatch";
+    else if(h->sgp4RecordSize != sizeof(Sgp4Record)) error = "SGP4 record layout mismatch (rebuild the catalog)";
+    else if(!MappedFile::SectionFits(h->recordsOffset, h->recordCount, sizeof(CatalogRecord), length) ||
+            !MappedFile::SectionFits(h->sgp4Offset, h->sgp4Count, sizeof(Sgp4Record), length) ||
+            !MappedFile::SectionFits(h->indexOffset, h->recordCount, sizeof(CatalogIdEntry), length) ||
+            !MappedFile::SectionFits(h->stringsOffset, h->stringsSize, 1, length))
+        error = "truncated file";
+    
+    if(error) {
+        LOG_ERROR("Invalid binary catalog " << filepath << ": " << error);
+        return false;
+    }
+    
+    mapping = file;
+    header = h;
+    recordTable = reinterpret_cast<const CatalogRecord*>(base + h->recordsOffset);
+    sgp4Table = reinterpret_cast<const Sgp4Record*>(base + h->sgp4Offset);
+    idIndex = reinterpret_cast<const CatalogIdEntry*>(base + h->indexOffset);
+    strings = base + h->stringsOffset;
+    return true;
+}
+
+void BinaryCatalog::close() {
+    mapping.reset(); // Unmapped once no satellite references it either
+    header = nullptr;
+    recordTable = nullptr;
+    sgp4Table = nullptr;
+    idIndex = nullptr;
+    strings = nullptr;
+}
+
+std::string_view BinaryCatalog::name(size_t record) const {
+    const CatalogRecord& r = recordTable[record];
+    if((uint64_t)r.nameOffset + r.nameLength > header->stringsSize) return std::string_view();
+    return std::string_view(strings + r.nameOffset, r.nameLength);
+}
+
+const CatalogRecord* BinaryCatalog::findById(int id) const {
+    if(!header) return nullptr;
+    const CatalogIdEntry* end = idIndex + header->recordCount;
+    const CatalogIdEntry* it = std::lower_bound(idIndex, end, id,
+        [](const CatalogIdEntry& e, int value) { return e.id < value; });
+    if(it == end || it->id != id || it->record >= header->recordCount) return nullptr;
+    return &recordTable[it->record];
+}
+
+std::vector<Satellite> BinaryCatalog::toSatellites() const {
+    std::vector<Satellite> satellites;
+    if(!header) return satellites;
+    satellites.reserve(header->recordCount);
+    
+    for(size_t k = 0; k < header->recordCount; ++k) {
+        satellites.push_back(MakeSatellite(recordTable[k], name(k), sgp4Table, header->sgp4Count, mapping));
+    }
+    return satellites;
+}
+
+CatalogView BinaryCatalog::view() const {
+    CatalogView v;
+    if(!header) return v;
+    v.records = recordTable;
+    v.recordCount = header->recordCount;
+    v.idIndex = idIndex;
+    v.sgp4Table = sgp4Table;
+    v.sgp4Count = header->sgp4Count;
+    v.strings = strings;
+    v.stringsSize = header->stringsSize;
+    v.owner = mapping;
+    return v;
+}
+
+Satellite BinaryCatalog::MakeSatellite(const CatalogRecord& r, std::string_view name,
+                                       const Sgp4Record* sgp4Table, uint64_t sgp4Count,
+                                       const std::shared_ptr<const void>& owner) {
+    Satellite s;
+    s.id = r.id;
+    s.name = name;
+    s.semiMajorAxis = r.semiMajorAxis;
+    s.eccentricity = r.eccentricity;
+    s.inclination = r.inclination;
+    s.raan = r.raan;
+    s.argPeriapsis = r.argPeriapsis;
+    s.meanAnomaly = r.meanAnomaly;
+    s.color = glm::vec3(r.color[0], r.color[1], r.color[2]);
+    s.active = !(r.flags & CATALOG_INACTIVE);
+    
+    // Aliasing pointer: shares ownership of the mapping, points at the mapped record
+    if(r.sgp4Index >= 0 && (uint64_t)r.sgp4Index < sgp4Count) {
+        s.sgp4 = std::shared_ptr<const Sgp4Record>(owner, &sgp4Table[r.sgp4Index]);
+    }
+    return s;
+}
+
+CatalogRecord BinaryCatalog::MakeRecord(const Satellite& s, std::string& pool, std::vector<Sgp4Record>& sgp4) {
+    CatalogRecord r;
+    memset(&r, 0, sizeof(r));
+    r.id = s.id;
+    r.nameOffset = (uint32_t)pool.size();
+    r.nameLength = (uint32_t)s.name.size();
+    pool += s.name;
+    r.sgp4Index = -1;
+    if(s.sgp4) {
+        r.sgp4Index = (int32_t)sgp4.size();
+        sgp4.push_back(*s.sgp4);
+    }
+    r.semiMajorAxis = s.semiMajorAxis;
+    r.eccentricity = s.eccentricity;
+    r.inclination = s.inclination;
+    r.raan = s.raan;
+    r.argPeriapsis = s.argPeriapsis;
+    r.meanAnomaly = s.meanAnomaly;
+    r.color[0] = s.color.r; r.color[1] = s.color.g; r.color[2] = s.color.b;
+    r.flags = s.active ? 0 : CATALOG_INACTIVE;
+    return r;
+}
+
+bool BinaryCatalog::Write(const std::string& filepath, const std::vector<Satellite>& satellites,
+                          double scenarioEpochJd) {
+    std::vector<CatalogRecord> records(satellites.size());
+    std::vector<Sgp4Record> sgp4;
+    std::vector<CatalogIdEntry> index(satellites.size());
+    std::string pool;
+    
+    for(size_t k = 0; k < satellites.size(); ++k) {
+        records[k] = MakeRecord(satellites[k], pool, sgp4);
+        index[k] = {satellites[k].id, (uint32_t)k};
+    }
+    std::stable_sort(index.begin(), index.end(), [](const CatalogIdEntry& a, const CatalogIdEntry& b) {
+        return a.id < b.id;
+    });
+    
+    CatalogHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+    h.version = CATALOG_VERSION;
+    h.headerSize = sizeof(CatalogHeader);
+    h.recordSize = sizeof(CatalogRecord);
+    h.sgp4RecordSize = sizeof(Sgp4Record);
+    h.recordCount = records.size();
+    h.sgp4Count = sgp4.size();
+    h.recordsOffset = AlignUp(sizeof(CatalogHeader));
+    h.sgp4Offset = AlignUp(h.recordsOffset + records.size() * sizeof(CatalogRecord));
+    h.indexOffset = AlignUp(h.sgp4Offset + sgp4.size() * sizeof(Sgp4Record));
+    h.stringsOffset = AlignUp(h.indexOffset + index.size() * sizeof(CatalogIdEntry));
+    h.stringsSize = pool.size();
+    h.scenarioEpochJd = scenarioEpochJd;
+    
+    std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+    if(!out.is_open()) {
+        LOG_ERROR("Failed to write binary catalog: " << filepath);
+        return false;
+    }
+    
+    auto writeAt = [&](uint64_t offset, const void* data, size_t bytes) {
+        static const char zeros[8] = {};
+        uint64_t pos = (uint64_t)out.tellp();
+        if(offset > pos) out.write(zeros, offset - pos); // Alignment padding
+        if(bytes) out.write(static_cast<const char*>(data), bytes);
+    };
+    writeAt(0, &h, sizeof(h));
+    writeAt(h.recordsOffset, records.data(), records.size() * sizeof(CatalogRecord));
+    writeAt(h.sgp4Offset, sgp4.data(), sgp4.size() * sizeof(Sgp4Record));
+    writeAt(h.indexOffset, index.data(), index.size() * sizeof(CatalogIdEntry));
+    writeAt(h.stringsOffset, pool.data(), pool.size());
+    
+    if(!out.good()) {
+        LOG_ERROR("Error writing binary catalog: " << filepath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../scene/Satellite.h"
+#include "../sim/Sgp4Propagator.h"
+
+class MappedFile;
+
+// Versioned binary catalog (.satcat), memory-mapped for startup in
+// milliseconds at any catalog size. Little-endian, every section 8-byte aligned:
+//
+//   CatalogHeader
+//   CatalogRecord[recordCount]      fixed-size element records
+//   Sgp4Record[sgp4Count]           pre-initialized SGP4 state of TLE objects
+//   CatalogIdEntry[recordCount]     id index, sorted by id
+//   char[stringsSize]               string pool (names, not NUL-terminated)
+//
+// Sgp4Record is stored as its in-memory layout; sgp4RecordSize guards
+// against files written by an incompatible build.
+
+const uint32_t CATALOG_VERSION = 2;
+
+struct CatalogHeader {
+    char magic[8];            // "SATCAT\0\0"
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t sgp4RecordSize;
+    uint64_t recordCount;
+    uint64_t sgp4Count;
+    uint64_t recordsOffset;
+    uint64_t sgp4Offset;
+    uint64_t indexOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    double scenarioEpochJd;   // UTC Julian date of sim time 0, 0 if unknown
+};
+
+struct CatalogRecord {
+    int32_t id;
+    uint32_t nameOffset;      // Into the string pool
+    uint32_t nameLength;
+    int32_t sgp4Index;        // Into the SGP4 table, -1 for two-body objects
+    float semiMajorAxis;      // km
+    float eccentricity;
+    float inclination;        // rad
+    float raan;               // rad
+    float argPeriapsis;       // rad
+    float meanAnomaly;        // rad, at sim time 0
+    float color[3];
+    uint32_t flags;           // CATALOG_INACTIVE
+};
+
+const uint32_t CATALOG_INACTIVE = 1u << 0;
+
+struct CatalogIdEntry {
+    int32_t id;
+    uint32_t record;
+};
+
+// The mapped tables of a catalog or checkpoint, for bulk loading into the
+// simulation (SatelliteCatalog::addCatalog) without a Satellite per record.
+// SGP4 pointers share ownership of owner, the mapping the tables live in.
+struct CatalogView {
+    const CatalogRecord* records = nullptr;
+    size_t recordCount = 0;
+    const CatalogIdEntry* idIndex = nullptr; // Sorted by id; nullptr when the file has none
+    const Sgp4Record* sgp4Table = nullptr;
+    uint64_t sgp4Count = 0;
+    const char* strings = nullptr;
+    uint64_t stringsSize = 0;
+    std::shared_ptr<const void> owner;
+};
+
+class BinaryCatalog {
+public:
+    BinaryCatalog() = default;
+    
+    // Maps and validates the file; false (with a message) if it is not a compatible catalog
+    bool open(const std::string& filepath);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+    
+    // Zero-copy views into the mapping, valid while the catalog is open
+    size_t size() const { return header ? header->recordCount : 0; }
+    double getScenarioEpochJd() const { return header ? header->scenarioEpochJd : 0.0; }
+    const CatalogRecord* records() const { return recordTable; }
+    const Sgp4Record* sgp4Records() const { return sgp4Table; }
+    std::string_view name(size_t record) const;
+    const CatalogRecord* findById(int id) const; // Binary search of the id index
+    
+    // Catalog entries for the simulation. SGP4 records are not copied: the
+    // satellites point into the mapping, which stays alive as long as they do.
+    std::vector<Satellite> toSatellites() const;
+    CatalogView view() const; // Same, as tables for a bulk load
+    
+    // Converter: writes satellites (from JSON, TLE, ...) in the binary format
+    static bool Write(const std::string& filepath, const std::vector<Satellite>& satellites,
+                      double scenarioEpochJd = 0.0);
+    
+    // Record conversion, shared with the checkpoint format. MakeRecord appends
+    // the name to pool and the SGP4 state (if any) to sgp4. MakeSatellite's
+    // SGP4 pointer shares ownership of owner (the mapping it points into).
+    static CatalogRecord MakeRecord(const Satellite& sat, std::string& pool, std::vector<Sgp4Record>& sgp4);
+    static Satellite MakeSatellite(const CatalogRecord& record, std::string_view name,
+                                   const Sgp4Record* sgp4Table, uint64_t sgp4Count,
+                                   const std::shared_ptr<const void>& owner);
+
+private:
+    std::shared_ptr<MappedFile> mapping; // Shared with every satellite that references its SGP4 table
+    
+    const CatalogHeader* header = nullptr;
+    const CatalogRecord* recordTable = nullptr;
+    const Sgp4Record* sgp4Table = nullptr;
+    const CatalogIdEntry* idIndex = nullptr;
+    const char* strings = nullptr;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Fixed-capacity lock-free queue (Vyukov's bounded MPMC ring). Any number of
+// threads may push and pop; neither side ever blocks, a full queue simply
+// refuses the push. Capacity is rounded up to a power of two.
+template<typename T>
+class BoundedQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "queued items are copied between threads by value");
+
+public:
+    explicit BoundedQueue(size_t capacity) {
+        size_t n = 2;
+        while(n < capacity) n <<= 1;
+        mask = n - 1;
+        cells = std::make_unique<Cell[]>(n);
+        for(size_t i = 0; i < n; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    
+    size_t capacity() const { return mask + 1; }
+    
+    bool tryPush(const T& item) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for(;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if(diff == 0) {
+                if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                return false; // Full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool tryPop(T& item) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for(;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if(diff == 0) {
+                if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = cell.value;
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                return false; // Empty
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Approximate while other threads are pushing or popping
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    
+    // Producers and consumers on separate cache lines
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+};
@@ -0,0 +1,177 @@
+#include "CatalogIngest.h"
+#include "BinaryCatalog.h"
+#include "SatelliteJsonSax.h"
+#include "ThreadPool.h"
+#include "Log.h"
+#include "../sim/Sgp4Propagator.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <unordered_set>
+
+using json = nlohmann::json;
+
+namespace {
+const size_t MAX_DUPLICATE_REPORTS = 10;
+
+// JSON lines: every line start is a record start
+const char* AlignToLine(const char* candidate, const char*) {
+    return candidate;
+}
+
+bool IsBlank(const char* begin, const char* end) {
+    for(const char* p = begin; p < end; ++p) {
+        if(*p != ' ' && *p != '\t' && *p != '\r') return false;
+    }
+    return true;
+}
+}
+
+std::vector<CatalogIngest::Chunk> CatalogIngest::Split(const char* begin, const char* end, size_t maxChunks,
+                                                       RecordAlign align) {
+    std::vector<Chunk> chunks;
+    size_t target = std::max<size_t>(MIN_CHUNK_BYTES, (size_t)(end - begin) / std::max<size_t>(maxChunks, 1));
+    
+    const char* start = begin;
+    size_t line = 1;
+    while(start < end) {
+        const char* split = end;
+        if((size_t)(end - start) > target) {
+            // Next line start after the target size, then on to a record start
+            const char* eol = static_cast<const char*>(memchr(start + target, '\n', end - (start + target)));
+            split = eol ? align(eol + 1, end) : end;
+        }
+        chunks.push_back({start, split, line});
+        line += std::count(start, split, '\n');
+        start = split;
+    }
+    return chunks;
+}
+
+size_t CatalogIngest::DefaultChunkCount() {
+    return (size_t)ThreadPool::DefaultThreadCount() * 4;
+}
+
+size_t CatalogIngest::RemoveDuplicateIds(std::vector<Satellite>& satellites, const std::string& source) {
+    std::unordered_set<int> seen;
+    seen.reserve(satellites.size());
+    
+    size_t kept = 0;
+    size_t dropped = 0;
+    for(size_t k = 0; k < satellites.size(); ++k) {
+        if(!seen.insert(satellites[k].id).second) {
+            if(dropped++ < MAX_DUPLICATE_REPORTS) {
+                LOG_WARN("Duplicate satellite id " << satellites[k].id << " in " << source
+                         << " (keeping the first entry)");
+            }
+            continue;
+        }
+        if(kept != k) satellites[kept] = std::move(satellites[k]);
+        kept++;
+    }
+    satellites.resize(kept);
+    
+    if(dropped > MAX_DUPLICATE_REPORTS) {
+        LOG_WARN("... " << dropped - MAX_DUPLICATE_REPORTS << " more duplicate ids not shown");
+    }
+    return dropped;
+}
+
+namespace {
+// Ids on their own line, so neither message outgrows the logger's fixed slot
+void ReportDeepSpace(size_t count, const std::ostringstream& examples) {
+    if(count == 0) return;
+    LOG_WARN(count << " deep-space objects (period >= 225 min) lack SDP4 terms (km/day error);"
+             << " their conjunctions are flagged low confidence");
+    LOG_WARN("Deep-space ids: " << examples.str() << (count > MAX_DUPLICATE_REPORTS ? ", ..." : ""));
+}
+}
+
+size_t CatalogIngest::WarnDeepSpace(const std::vector<Satellite>& satellites) {
+    size_t count = 0;
+    std::ostringstream examples;
+    for(const auto& s : satellites) {
+        if(!s.sgp4 || !s.sgp4->deepSpace) continue;
+        if(count++ < MAX_DUPLICATE_REPORTS) examples << (count > 1 ? ", " : "") << s.id;
+    }
+    ReportDeepSpace(count, examples);
+    return count;
+}
+
+size_t CatalogIngest::WarnDeepSpace(const CatalogView& view) {
+    size_t count = 0;
+    std::ostringstream examples;
+    for(size_t k = 0; k < view.recordCount; ++k) {
+        const CatalogRecord& r = view.records[k];
+        if(r.sgp4Index < 0 || (uint64_t)r.sgp4Index >= view.sgp4Count || !view.sgp4Table[r.sgp4Index].deepSpace) continue;
+        if(count++ < MAX_DUPLICATE_REPORTS) examples << (count > 1 ? ", " : "") << r.id;
+    }
+    ReportDeepSpace(count, examples);
+    return count;
+}
+
+std::vector<Satellite> CatalogIngest::LoadJsonLines(const std::string& filepath) {
+    MappedFile file;
+    if(!file.open(filepath)) {
+        LOG_ERROR("Failed to open config: " << filepath);
+        return {};
+    }
+    
+    std::vector<Chunk> chunks = Split(file.begin(), file.end(), DefaultChunkCount(), AlignToLine);
+    
+    struct ChunkResult {
+        std::vector<Satellite> satellites;
+        std::ostringstream log;
+        size_t skipped = 0;
+    };
+    std::vector<ChunkResult> results(chunks.size());
+    ThreadPool pool(std::min<int>(ThreadPool::DefaultThreadCount(), (int)chunks.size()));
+    
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end, int) {
+        for(size_t c = begin; c < end; ++c) {
+            const Chunk& chunk = chunks[c];
+            ChunkResult& r = results[c];
+            size_t line = chunk.firstLine;
+            
+            for(const char* p = chunk.begin; p < chunk.end; ++line) {
+                const char* eol = static_cast<const char*>(memchr(p, '\n', chunk.end - p));
+                if(!eol) eol = chunk.end;
+                
+                if(!IsBlank(p, eol)) {
+                    size_t before = r.satellites.size();
+                    SatelliteJsonSax handler(r.satellites, line, r.log, SatelliteJsonSax::SINGLE_RECORD);
+                    json::sax_parse(p, eol, &handler);
+                    if(!handler.getParseError().empty()) {
+                        r.satellites.resize(before); // Drop a record followed by garbage too
+                        r.log << "JSON Parse Error (line " << line << "): " << handler.getParseError() << std::endl;
+                        r.skipped++;
+                    } else {
+                        r.skipped += handler.getSkippedCount();
+                    }
+                }
+                p = eol + 1;
+            }
+        }
+    });
+    
+    std::vector<Satellite> satellites;
+    size_t total = 0;
+    size_t skipped = 0;
+    for(const auto& r : results) {
+        total += r.satellites.size();
+        skipped += r.skipped;
+    }
+    satellites.reserve(total);
+    Log::Flush(); // Per-record diagnostics go straight to stdout, after anything queued
+    for(auto& r : results) {
+        std::cout << r.log.str();
+        std::move(r.satellites.begin(), r.satellites.end(), std::back_inserter(satellites));
+    }
+    size_t duplicates = RemoveDuplicateIds(satellites, filepath);
+    
+    LOG_INFO("Loaded " << satellites.size() << " satellites from " << filepath << " (" << skipped
+             << " bad lines skipped, " << duplicates << " duplicates, " << chunks.size() << " chunks)");
+    return satellites;
+}
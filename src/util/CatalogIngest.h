@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "../scene/Satellite.h"
+#include "MappedFile.h"
+
+struct CatalogView;
+
+// Shared pieces of the parallel text-catalog loaders (TLE/3LE, JSON lines):
+// the mapped file is cut into chunks that each start on a record, the chunks
+// are parsed on a worker pool into their own buffers, and the buffers are
+// concatenated in chunk order so the result matches a sequential parse.
+class CatalogIngest {
+public:
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        size_t firstLine; // 1-based line number of begin, for error messages
+    };
+    
+    // Moves a candidate split point (always a line start) forward to the
+    // start of the next record; returns end if there is none
+    using RecordAlign = const char* (*)(const char* candidate, const char* end);
+    
+    // Cuts [begin, end) into at most maxChunks pieces of roughly equal size,
+    // none smaller than MIN_CHUNK_BYTES, each starting on a record boundary
+    static std::vector<Chunk> Split(const char* begin, const char* end, size_t maxChunks, RecordAlign align);
+    
+    // Chunks to aim for on this machine: a few per core for load balance
+    static size_t DefaultChunkCount();
+    
+    // Keeps the first occurrence of each id (file order) and drops later
+    // ones with a report. Returns the number dropped.
+    static size_t RemoveDuplicateIds(std::vector<Satellite>& satellites, const std::string& source);
+    
+    // Warns about SGP4 objects with a period of 225 min or more (GEO, GNSS,
+    // Molniya). They run on the near-Earth model without the lunar/solar and
+    // resonance terms, so their error grows by kilometres per day; the
+    // analyzer flags their conjunctions (deep_space). Returns how many there are.
+    static size_t WarnDeepSpace(const std::vector<Satellite>& satellites);
+    static size_t WarnDeepSpace(const CatalogView& view);
+    
+    // Newline-delimited JSON (.jsonl, .ndjson): one satellite object per line,
+    // same fields as the JSON catalog. Parsed in parallel; a bad line is
+    // reported and skipped.
+    static std::vector<Satellite> LoadJsonLines(const std::string& filepath);
+    
+    static const size_t MIN_CHUNK_BYTES = 256 * 1024;
+};
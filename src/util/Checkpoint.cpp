@@ -0,0 +1,222 @@
+#include "Checkpoint.h"
+#include "MappedFile.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+static_assert(sizeof(CheckpointHeader) == 168, "CheckpointHeader layout is part of the file format");
+static_assert(sizeof(CheckpointPair) == 8, "CheckpointPair layout is part of the file format");
+static_assert(std::is_trivially_copyable<Particle>::value, "Particle is stored byte-for-byte");
+static_assert(std::is_trivially_copyable<ConjunctionEvent>::value, "ConjunctionEvent is stored byte-for-byte");
+
+namespace {
+const char CHECKPOINT_MAGIC[8] = {'S', 'A', 'T', 'C', 'K', 'P', 'T', 0};
+
+uint64_t AlignUp(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+}
+
+bool Checkpoint::open(const std::string& filepath) {
+    close();
+    
+    auto file = std::make_shared<MappedFile>();
+    if(!file->open(filepath)) {
+        LOG_ERROR("Failed to open checkpoint: " << filepath);
+        return false;
+    }
+    if(file->size() < sizeof(CheckpointHeader)) {
+        LOG_ERROR("Checkpoint too small: " << filepath);
+        return false;
+    }
+    
+    const char* base = file->begin();
+    const CheckpointHeader* h = reinterpret_cast<const CheckpointHeader*>(base);
+    size_t length = file->size();
+    
+    // Validate before exposing anything
+    const char* error = nullptr;
+    if(memcmp(h->magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) error = "not a checkpoint";
+    else if(h->version != CHECKPOINT_VERSION) error = "unsupported checkpoint version";
+    else if(h->headerSize != sizeof(CheckpointHeader) || h->recordSize != sizeof(CatalogRecord) ||
+            h->particleSize != sizeof(Particle) || h->eventSize != sizeof(ConjunctionEvent))
+        error = "record layout mismatch";
+    else if(h->sgp4RecordSize != sizeof(Sgp4Record)) error = "SGP4 record layout mismatch (written by another build)";
+    else if(!MappedFile::SectionFits(h->recordsOffset, h->recordCount, sizeof(CatalogRecord), length) ||
+            !MappedFile::SectionFits(h->sgp4Offset, h->sgp4Count, sizeof(Sgp4Record), length) ||
+            !MappedFile::SectionFits(h->particlesOffset, h->particleCount, sizeof(Particle), length) ||
+            !MappedFile::SectionFits(h->pairsOffset, h->pairCount, sizeof(CheckpointPair), length) ||
+            !MappedFile::SectionFits(h->eventsOffset, h->eventCount, sizeof(ConjunctionEvent), length) ||
+            !MappedFile::SectionFits(h->stringsOffset, h->stringsSize, 1, length))
+        error = "truncated file";
+    
+    if(error) {
+        LOG_ERROR("Invalid checkpoint " << filepath << ": " << error);
+        return false;
+    }
+    
+    mapping = file;
+    header = h;
+    recordTable = reinterpret_cast<const CatalogRecord*>(base + h->recordsOffset);
+    sgp4Table = reinterpret_cast<const Sgp4Record*>(base + h->sgp4Offset);
+    particleTable = reinterpret_cast<const Particle*>(base + h->particlesOffset);
+    pairTable = reinterpret_cast<const CheckpointPair*>(base + h->pairsOffset);
+    eventTable = reinterpret_cast<const ConjunctionEvent*>(base + h->eventsOffset);
+    strings = base + h->stringsOffset;
+    return true;
+}
+
+void Checkpoint::close() {
+    mapping.reset(); // Unmapped once no satellite references it either
+    header = nullptr;
+    recordTable = nullptr;
+    sgp4Table = nullptr;
+    particleTable = nullptr;
+    pairTable = nullptr;
+    eventTable = nullptr;
+    strings = nullptr;
+}
+
+ConjunctionAnalyzer::ScreeningState Checkpoint::getScreeningState() const {
+    return {header->screeningValid != 0, header->screenedUntil, (size_t)header->screenedSatelliteCount};
+}
+
+std::vector<Satellite> Checkpoint::toSatellites() const {
+    std::vector<Satellite> satellites;
+    if(!header) return satellites;
+    satellites.reserve(header->recordCount);
+    
+    for(size_t k = 0; k < header->recordCount; ++k) {
+        const CatalogRecord& r = recordTable[k];
+        std::string_view name;
+        if((uint64_t)r.nameOffset + r.nameLength <= header->stringsSize) name = std::string_view(strings + r.nameOffset, r.nameLength);
+        satellites.push_back(BinaryCatalog::MakeSatellite(r, name, sgp4Table, header->sgp4Count, mapping));
+    }
+    return satellites;
+}
+
+CatalogView Checkpoint::catalogView() const {
+    CatalogView v;
+    if(!header) return v;
+    v.records = recordTable;
+    v.recordCount = header->recordCount;
+    v.sgp4Table = sgp4Table;
+    v.sgp4Count = header->sgp4Count;
+    v.strings = strings;
+    v.stringsSize = header->stringsSize;
+    v.owner = mapping;
+    return v;
+}
+
+std::vector<std::pair<int,int>> Checkpoint::getActiveCollisions() const {
+    std::vector<std::pair<int,int>> pairs;
+    if(!header) return pairs;
+    pairs.reserve(header->pairCount);
+    for(size_t k = 0; k < header->pairCount; ++k) pairs.emplace_back(pairTable[k].sat1, pairTable[k].sat2);
+    return pairs;
+}
+
+bool Checkpoint::Write(const std::string& filepath, const CheckpointState& state) {
+    std::vector<CatalogRecord> records;
+    std::vector<Sgp4Record> sgp4;
+    std::string pool;
+    records.reserve(state.satellites.size());
+    for(const auto& s : state.satellites) records.push_back(BinaryCatalog::MakeRecord(s, pool, sgp4));
+    
+    std::vector<CheckpointPair> pairs;
+    pairs.reserve(state.activeCollisions.size());
+    for(const auto& p : state.activeCollisions) pairs.push_back({p.first, p.second});
+    
+    CheckpointHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    h.version = CHECKPOINT_VERSION;
+    h.headerSize = sizeof(CheckpointHeader);
+    h.recordSize = sizeof(CatalogRecord);
+    h.sgp4RecordSize = sizeof(Sgp4Record);
+    h.particleSize = sizeof(Particle);
+    h.eventSize = sizeof(ConjunctionEvent);
+    h.simTime = state.simTime;
+    h.conjunctionTimer = state.conjunctionTimer;
+    h.screeningValid = state.screening.valid ? 1 : 0;
+    h.screenedUntil = state.screening.screenedUntil;
+    h.screenedSatelliteCount = state.screening.satelliteCount;
+    h.recordCount = records.size();
+    h.sgp4Count = sgp4.size();
+    h.particleCount = state.particles.size();
+    h.pairCount = pairs.size();
+    h.eventCount = state.events.size();
+    h.recordsOffset = AlignUp(sizeof(CheckpointHeader));
+    h.sgp4Offset = AlignUp(h.recordsOffset + records.size() * sizeof(CatalogRecord));
+    h.particlesOffset = AlignUp(h.sgp4Offset + sgp4.size() * sizeof(Sgp4Record));
+    h.pairsOffset = AlignUp(h.particlesOffset + state.particles.size() * sizeof(Particle));
+    h.eventsOffset = AlignUp(h.pairsOffset + pairs.size() * sizeof(CheckpointPair));
+    h.stringsOffset = AlignUp(h.eventsOffset + state.events.size() * sizeof(ConjunctionEvent));
+    h.stringsSize = pool.size();
+    h.scenarioEpochJd = state.scenarioEpochJd;
+    
+    std::string tmpPath = filepath + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if(!out.is_open()) {
+        LOG_ERROR("Failed to write checkpoint: " << tmpPath);
+        return false;
+    }
+    
+    auto writeAt = [&](uint64_t offset, const void* data, size_t bytes) {
+        static const char zeros[8] = {};
+        uint64_t pos = (uint64_t)out.tellp();
+        if(offset > pos) out.write(zeros, offset - pos); // Alignment padding
+        if(bytes) out.write(static_cast<const char*>(data), bytes);
+    };
+    writeAt(0, &h, sizeof(h));
+    writeAt(h.recordsOffset, records.data(), records.size() * sizeof(CatalogRecord));
+    writeAt(h.sgp4Offset, sgp4.data(), sgp4.size() * sizeof(Sgp4Record));
+    writeAt(h.particlesOffset, state.particles.data(), state.particles.size() * sizeof(Particle));
+    writeAt(h.pairsOffset, pairs.data(), pairs.size() * sizeof(CheckpointPair));
+    writeAt(h.eventsOffset, state.events.data(), state.events.size() * sizeof(ConjunctionEvent));
+    writeAt(h.stringsOffset, pool.data(), pool.size());
+    
+    out.close();
+    if(out.fail()) {
+        LOG_ERROR("Error writing checkpoint: " << tmpPath);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    if(std::rename(tmpPath.c_str(), filepath.c_str()) != 0) {
+        LOG_ERROR("Failed to replace checkpoint: " << filepath);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    wait();
+}
+
+bool CheckpointWriter::save(const std::string& path, CheckpointState state) {
+    if(busy.load()) return false;
+    if(worker.joinable()) worker.join(); // Previous save already finished
+    
+    busy = true;
+    worker = std::thread([this, path, state = std::move(state)]() {
+        auto start = std::chrono::steady_clock::now();
+        if(Checkpoint::Write(path, state)) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            LOG_INFO("Checkpoint saved: " << path << " (t=" << state.simTime << " s, "
+                     << state.satellites.size() << " satellites, " << ms << " ms)");
+            savedCount++;
+        } else {
+            failedCount++;
+        }
+        busy = false;
+    });
+    return true;
+}
+
+void CheckpointWriter::wait() {
+    if(worker.joinable()) worker.join();
+}
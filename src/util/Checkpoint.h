@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../scene/Satellite.h"
+#include "../scene/Particle.h"
+#include "../sim/conjunctions/ConjunctionAnalyzer.h"
+#include "BinaryCatalog.h"
+
+class MappedFile;
+
+// Binary simulation checkpoint (.satckpt): the whole mutable state of a run in
+// one file that is memory-mapped back in on resume. Same conventions as the
+// binary catalog (little-endian, 8-byte aligned sections, in-memory layouts
+// guarded by size fields):
+//
+//   CheckpointHeader                sim time, timers, screening progress
+//   CatalogRecord[recordCount]      satellites, including destroyed ones
+//   Sgp4Record[sgp4Count]
+//   Particle[particleCount]         debris (windowed app only)
+//   CheckpointPair[pairCount]       collisions still in contact
+//   ConjunctionEvent[eventCount]    analyzer results
+//   char[stringsSize]               satellite names
+
+const uint32_t CHECKPOINT_VERSION = 3;
+
+struct CheckpointHeader {
+    char magic[8];            // "SATCKPT\0"
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t sgp4RecordSize;
+    uint32_t particleSize;
+    uint32_t eventSize;
+    double simTime;
+    float conjunctionTimer;
+    uint32_t screeningValid;
+    double screenedUntil;
+    uint64_t screenedSatelliteCount;
+    uint64_t recordCount;
+    uint64_t sgp4Count;
+    uint64_t particleCount;
+    uint64_t pairCount;
+    uint64_t eventCount;
+    uint64_t recordsOffset;
+    uint64_t sgp4Offset;
+    uint64_t particlesOffset;
+    uint64_t pairsOffset;
+    uint64_t eventsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    double scenarioEpochJd;   // UTC Julian date of sim time 0, 0 if unknown
+};
+
+struct CheckpointPair {
+    int32_t sat1;
+    int32_t sat2;
+};
+
+// Everything a checkpoint holds, captured by value so it can be written while
+// the simulation keeps running
+struct CheckpointState {
+    SimTime simTime = 0.0;
+    double scenarioEpochJd = 0.0; // From the loaded catalog, for dated exports after a resume
+    float conjunctionTimer = 0.0f;
+    std::vector<Satellite> satellites;
+    std::vector<Particle> particles;
+    std::vector<std::pair<int,int>> activeCollisions;
+    std::vector<ConjunctionEvent> events;
+    ConjunctionAnalyzer::ScreeningState screening{false, 0.0, 0};
+};
+
+class Checkpoint {
+public:
+    Checkpoint() = default;
+    
+    // Maps and validates the file; false (with a message) if it is not a compatible checkpoint
+    bool open(const std::string& filepath);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+    
+    SimTime getSimTime() const { return header->simTime; }
+    double getScenarioEpochJd() const { return header->scenarioEpochJd; }
+    float getConjunctionTimer() const { return header->conjunctionTimer; }
+    ConjunctionAnalyzer::ScreeningState getScreeningState() const;
+    
+    // Satellites share the mapping for their SGP4 state, like BinaryCatalog::toSatellites
+    std::vector<Satellite> toSatellites() const;
+    CatalogView catalogView() const; // The satellite tables, for SatelliteCatalog::addCatalog
+    std::vector<std::pair<int,int>> getActiveCollisions() const;
+    
+    // Zero-copy views into the mapping, valid while the checkpoint is open
+    const Particle* particles() const { return particleTable; }
+    size_t particleCount() const { return header ? header->particleCount : 0; }
+    const ConjunctionEvent* events() const { return eventTable; }
+    size_t eventCount() const { return header ? header->eventCount : 0; }
+    
+    // Writes path + ".tmp" and renames it over path, so a crash mid-write
+    // never leaves a torn checkpoint behind
+    static bool Write(const std::string& filepath, const CheckpointState& state);
+
+private:
+    std::shared_ptr<MappedFile> mapping;
+    
+    const CheckpointHeader* header = nullptr;
+    const CatalogRecord* recordTable = nullptr;
+    const Sgp4Record* sgp4Table = nullptr;
+    const Particle* particleTable = nullptr;
+    const CheckpointPair* pairTable = nullptr;
+    const ConjunctionEvent* eventTable = nullptr;
+    const char* strings = nullptr;
+};
+
+// Writes checkpoints on a background thread. The caller only pays for copying
+// the state; serialization and disk I/O overlap with the following frames.
+class CheckpointWriter {
+public:
+    CheckpointWriter() = default;
+    ~CheckpointWriter(); // Finishes a save in progress
+    
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+    
+    // Starts writing state to path. Returns false without doing anything while
+    // the previous checkpoint is still being written.
+    bool save(const std::string& path, CheckpointState state);
+    
+    bool isBusy() const { return busy.load(); }
+    void wait(); // Blocks until the save in progress (if any) is on disk
+    
+    size_t getSavedCount() const { return savedCount.load(); }
+    size_t getFailedCount() const { return failedCount.load(); }
+
+private:
+    std::thread worker;
+    std::atomic<bool> busy{false};
+    std::atomic<size_t> savedCount{0};
+    std::atomic<size_t> failedCount{0};
+};
@@ -1,7 +1,14 @@
 #include "ConfigLoader.h"
+#include "TleLoader.h"
+#include "BinaryCatalog.h"
+#include "CatalogIngest.h"
+#include "SatelliteJsonSax.h"
+#include "Log.h"
+#include "../sim/SatelliteCatalog.h"
 #include <fstream>
-#include <iostream>
 #include <vector>
+#include <cstring>
+#include <cctype>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -21,34 +28,85 @@ std::string ResolvePath(const std::string& requestedPath) {
     }
     return requestedPath;
 }
+
+bool HasExtension(const std::string& path, const char* ext) {
+    size_t n = strlen(ext);
+    if(path.size() < n) return false;
+    for(size_t k = 0; k < n; ++k) {
+        if(tolower((unsigned char)path[path.size() - n + k]) != ext[k]) return false;
+    }
+    return true;
+}
+}
+
+size_t ConfigLoader::LoadInto(SatelliteCatalog& catalog, const std::string& filepath, double* scenarioEpochJd) {
+    std::string resolved = ResolvePath(filepath);
+    if(!HasExtension(resolved, ".satcat")) {
+        std::vector<Satellite> satellites = LoadSatellites(filepath, scenarioEpochJd);
+        catalog.reserve(catalog.getSatellites().size() + satellites.size());
+        for(const auto& s : satellites) catalog.addSatellite(s);
+        return satellites.size();
+    }
+    
+    if(scenarioEpochJd) *scenarioEpochJd = 0.0;
+    BinaryCatalog file;
+    if(!file.open(resolved)) return 0;
+    if(scenarioEpochJd) *scenarioEpochJd = file.getScenarioEpochJd();
+    CatalogView view = file.view();
+    CatalogIngest::WarnDeepSpace(view);
+    return catalog.addCatalog(view); // The satellites keep the mapping alive for their SGP4 state
 }
 
-std::vector<Satellite> ConfigLoader::LoadSatellites(const std::string& filepath) {
+std::vector<Satellite> ConfigLoader::LoadSatellites(const std::string& filepath, double* scenarioEpochJd) {
     std::vector<Satellite> satellites;
     std::string resolved = ResolvePath(filepath);
+    if(scenarioEpochJd) *scenarioEpochJd = 0.0;
+    
+    // Pre-converted binary catalogs are mapped, not parsed
+    if(HasExtension(resolved, ".satcat")) {
+        BinaryCatalog catalog;
+        if(!catalog.open(resolved)) return satellites;
+        satellites = catalog.toSatellites();
+        if(scenarioEpochJd) *scenarioEpochJd = catalog.getScenarioEpochJd();
+        CatalogIngest::WarnDeepSpace(satellites);
+        return satellites;
+    }
+    
+    // Two/three-line element files go through the SGP4 loader
+    if(HasExtension(resolved, ".tle") || HasExtension(resolved, ".3le") || HasExtension(resolved, ".txt")) {
+        return TleLoader::LoadSatellites(resolved, scenarioEpochJd);
+    }
+    
+    // One JSON record per line: split and parsed in parallel
+    if(HasExtension(resolved, ".jsonl") || HasExtension(resolved, ".ndjson")) {
+        return CatalogIngest::LoadJsonLines(resolved);
+    }
+    
     std::ifstream f(resolved);
     if(!f.is_open()) {
-        std::cout << "Failed to open config: " << filepath << std::endl;
+        LOG_ERROR("Failed to open config: " << filepath);
         return satellites;
     }
     
+    // Streamed: records are filled as they are read and no DOM is built, so
+    // memory stays flat in the catalog size and one bad record does not
+    // discard the rest of the file
+    Log::Flush(); // The handler reports bad records straight to stdout
+    SatelliteJsonSax handler(satellites);
     try {
-        json data = json::parse(f);
-        for(const auto& item : data) {
-            Satellite s;
-            s.id = item["id"];
-            s.name = item.value("name", "Unknown");
-            s.semiMajorAxis = item["semiMajorAxis"];
-            s.eccentricity = item["eccentricity"];
-            s.inclination = glm::radians((float)item["inclination"]);
-            s.raan = glm::radians((float)item["raan"]);
-            s.argPeriapsis = glm::radians((float)item["argPeriapsis"]);
-            s.meanAnomaly = glm::radians((float)item["meanAnomaly"]);
-            s.color = glm::vec3(1.0f); // Default white
-            satellites.push_back(s);
-        }
+        json::sax_parse(f, &handler);
     } catch(const std::exception& e) {
-        std::cout << "JSON Parse Error: " << e.what() << std::endl;
+        LOG_ERROR("JSON Parse Error: " << e.what());
+    }
+    if(!handler.getParseError().empty()) {
+        LOG_ERROR("JSON Parse Error: " << handler.getParseError()
+                  << " (kept " << satellites.size() << " records read before it)");
+    } else if(!handler.foundList()) {
+        LOG_ERROR("No satellite list in " << filepath << " (expected an array or a \"satellites\" array)");
+    }
+    if(handler.getSkippedCount() > 0) {
+        LOG_WARN("Skipped " << handler.getSkippedCount() << " of " << handler.getRecordCount()
+                 << " satellite records in " << filepath);
     }
     return satellites;
 }
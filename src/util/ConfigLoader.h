@@ -1,9 +1,21 @@
 #pragma once
 #include <vector>
 #include <string>
-#include "../scene/SatelliteSystem.h"
+#include "../scene/Satellite.h"
+
+class SatelliteCatalog;
 
 class ConfigLoader {
 public:
-    static std::vector<Satellite> LoadSatellites(const std::string& filepath);
+    // JSON Keplerian elements (an array, or one object per line in .jsonl/.ndjson),
+    // TLE/3LE (.tle, .3le, .txt) propagated with SGP4, or a binary catalog
+    // (.satcat) written by satsim_catalog_convert. scenarioEpochJd, if given,
+    // receives the UTC Julian date of sim time 0, or 0 when the catalog has no
+    // absolute epoch (Keplerian JSON elements).
+    static std::vector<Satellite> LoadSatellites(const std::string& filepath, double* scenarioEpochJd = nullptr);
+    
+    // Same, straight into catalog. A .satcat is bulk-loaded from its mapped
+    // record table (SatelliteCatalog::addCatalog) without building a Satellite
+    // per record. Returns the number of satellites added.
+    static size_t LoadInto(SatelliteCatalog& catalog, const std::string& filepath, double* scenarioEpochJd = nullptr);
 };
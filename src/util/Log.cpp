@@ -0,0 +1,239 @@
+#include "Log.h"
+#include "BoundedQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+const size_t RING_SLOTS = 512;    // Per thread
+const size_t MESSAGE_BYTES = 240; // Longer messages are truncated
+const auto SINK_POLL = std::chrono::milliseconds(10);
+
+struct LogMessage {
+    uint64_t sequence; // Global order across threads
+    LogLevel level;
+    uint32_t length;
+    char text[MESSAGE_BYTES];
+};
+
+struct ThreadRing {
+    BoundedQueue<LogMessage> queue{RING_SLOTS};
+    std::atomic<size_t> dropped{0};
+    std::atomic<bool> orphaned{false}; // Owning thread exited; removed once drained
+};
+
+const char* LevelPrefix(LogLevel level) {
+    switch(level) {
+        case LogLevel::TRACE: return "[TRACE] ";
+        case LogLevel::DEBUG: return "[DEBUG] ";
+        case LogLevel::WARN: return "[WARN] ";
+        case LogLevel::ERROR: return "[ERROR] ";
+        default: return ""; // INFO reads like plain console output
+    }
+}
+
+int InitialLevel() {
+    LogLevel level = LogLevel::INFO;
+    if(const char* env = getenv("SATSIM_LOG_LEVEL")) Log::ParseLevel(env, level);
+    return (int)level;
+}
+
+// Background writer shared by all threads
+class Sink {
+public:
+    static Sink& Instance() {
+        static Sink sink;
+        return sink;
+    }
+    
+    ~Sink() {
+        stopping = true;
+        wake.notify_one();
+        if(thread.joinable()) thread.join(); // Drains every ring first
+    }
+    
+    std::shared_ptr<ThreadRing> registerThread() {
+        auto ring = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rings.push_back(ring);
+        return ring;
+    }
+    
+    uint64_t nextSequence() { return sequence.fetch_add(1, std::memory_order_relaxed); }
+    void queued() { queuedCount.fetch_add(1, std::memory_order_release); }
+    
+    void flush() {
+        size_t target = queuedCount.load(std::memory_order_acquire);
+        while(writtenCount.load(std::memory_order_acquire) < target) {
+            wake.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<size_t> queuedCount{0};
+    std::atomic<size_t> writtenCount{0};
+    std::thread thread; // Last: starts running once everything above is constructed
+    
+    Sink() : thread(&Sink::run, this) {}
+    
+    void run() {
+        std::vector<std::shared_ptr<ThreadRing>> snapshot;
+        std::vector<LogMessage> batch;
+        LogMessage msg;
+        
+        for(;;) {
+            {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                // Forget rings of exited threads once they are empty
+                rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<ThreadRing>& r) {
+                    return r->orphaned.load() && r->queue.empty() && r->dropped.load() == 0;
+                }), rings.end());
+                snapshot = rings;
+            }
+            
+            batch.clear();
+            size_t dropped = 0;
+            for(const auto& ring : snapshot) {
+                while(ring->queue.tryPop(msg)) batch.push_back(msg);
+                dropped += ring->dropped.exchange(0);
+            }
+            std::sort(batch.begin(), batch.end(), [](const LogMessage& a, const LogMessage& b) {
+                return a.sequence < b.sequence;
+            });
+            
+            for(const auto& m : batch) {
+                fputs(LevelPrefix(m.level), stdout);
+                fwrite(m.text, 1, m.length, stdout);
+                fputc('\n', stdout);
+            }
+            if(dropped > 0) fprintf(stdout, "[WARN] %zu log messages dropped (ring buffer full)\n", dropped);
+            if(!batch.empty() || dropped > 0) fflush(stdout); // One flush per batch, not per line
+            writtenCount.fetch_add(batch.size(), std::memory_order_release);
+            
+            if(batch.empty()) {
+                if(stopping) break;
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait_for(lock, SINK_POLL);
+            }
+        }
+    }
+};
+
+// Marks the thread's ring as orphaned when the thread exits
+struct ThreadRingHandle {
+    std::shared_ptr<ThreadRing> ring;
+    ~ThreadRingHandle() {
+        if(ring) ring->orphaned = true;
+    }
+};
+
+ThreadRing& CurrentRing() {
+    thread_local ThreadRingHandle handle;
+    if(!handle.ring) handle.ring = Sink::Instance().registerThread();
+    return *handle.ring;
+}
+
+// Every rate-limited call site, so Flush() can report what they held back.
+// Limits are function-local statics and outlive any Flush() call.
+struct RateLimitRegistry {
+    std::mutex mutex;
+    std::vector<Log::RateLimit*> limits;
+    
+    static RateLimitRegistry& Instance() {
+        static RateLimitRegistry registry;
+        return registry;
+    }
+};
+}
+
+std::atomic<int> Log::runtimeLevel{InitialLevel()};
+
+bool Log::ParseLevel(const std::string& name, LogLevel& level) {
+    static const char* const names[] = {"trace", "debug", "info", "warn", "error", "off"};
+    for(int k = 0; k <= (int)LogLevel::OFF; ++k) {
+        if(name == names[k]) {
+            level = (LogLevel)k;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::ostringstream& Log::Stream() {
+    thread_local std::ostringstream stream;
+    stream.str(std::string());
+    stream.clear();
+    return stream;
+}
+
+void Log::Write(LogLevel level, std::ostringstream& message) {
+    Sink& sink = Sink::Instance();
+    ThreadRing& ring = CurrentRing();
+    
+    LogMessage msg;
+    msg.sequence = sink.nextSequence();
+    msg.level = level;
+    std::string_view text = message.view(); // No copy of the buffer
+    msg.length = (uint32_t)std::min(text.size(), MESSAGE_BYTES);
+    memcpy(msg.text, text.data(), msg.length);
+    if(text.size() > MESSAGE_BYTES) memcpy(msg.text + MESSAGE_BYTES - 3, "...", 3);
+    
+    if(ring.queue.tryPush(msg)) sink.queued();
+    else ring.dropped++;
+}
+
+void Log::Flush() {
+    RateLimitRegistry& registry = RateLimitRegistry::Instance();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for(RateLimit* limit : registry.limits) limit->flushSuppressed();
+    }
+    Sink::Instance().flush();
+}
+
+Log::RateLimit::RateLimit(int maxPerSecond, LogLevel level, const char* file, int line)
+    : maxPerSecond(maxPerSecond), level(level), file(file), line(line) {
+    RateLimitRegistry& registry = RateLimitRegistry::Instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.limits.push_back(this);
+}
+
+void Log::RateLimit::flushSuppressed() {
+    size_t count = suppressed.exchange(0, std::memory_order_relaxed);
+    if(count == 0 || !IsEnabled(level)) return;
+    const char* name = strrchr(file, '/');
+    std::ostringstream& stream = Stream();
+    stream << count << " similar messages suppressed (" << (name ? name + 1 : file) << ":" << line << ")";
+    Write(level, stream);
+}
+
+bool Log::RateLimit::allow(size_t& suppressedBefore) {
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t start = windowStart.load(std::memory_order_relaxed);
+    if(now - start >= 1000 && windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        windowCount.store(0, std::memory_order_relaxed);
+    }
+    if(windowCount.fetch_add(1, std::memory_order_relaxed) >= maxPerSecond) {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressedBefore = suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// Leveled asynchronous logger. A call site formats its message into a
+// thread-local stream and pushes it onto that thread's lock-free ring
+// buffer; a background sink thread writes the rings to stdout in batches,
+// so hot loops never wait on a console flush. Messages from a full ring are
+// dropped and counted rather than blocking.
+//
+//   LOG_INFO("Found " << n << " conjunctions");
+//   LOG_DEBUG_RATE(2, "Updating " << count << " predictions"); // at most 2/s from this site
+//
+// Levels below SATSIM_LOG_COMPILE_LEVEL are compiled out entirely; the
+// runtime level (Log::SetLevel, or SATSIM_LOG_LEVEL in the environment)
+// filters before any formatting is done.
+
+enum class LogLevel {
+    TRACE = 0,
+    DEBUG = 1,
+    INFO = 2,
+    WARN = 3,
+    ERROR = 4,
+    OFF = 5
+};
+
+#ifndef SATSIM_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define SATSIM_LOG_COMPILE_LEVEL 1 // DEBUG
+#else
+#define SATSIM_LOG_COMPILE_LEVEL 0 // TRACE
+#endif
+#endif
+
+class Log {
+public:
+    static void SetLevel(LogLevel level) { runtimeLevel.store((int)level, std::memory_order_relaxed); }
+    static LogLevel GetLevel() { return (LogLevel)runtimeLevel.load(std::memory_order_relaxed); }
+    static bool IsEnabled(LogLevel level) { return (int)level >= runtimeLevel.load(std::memory_order_relaxed); }
+    
+    // "trace", "debug", "info", "warn", "error", "off"
+    static bool ParseLevel(const std::string& name, LogLevel& level);
+    
+    // Thread-local scratch stream for the macros, returned empty
+    static std::ostringstream& Stream();
+    
+    // Queues the stream's text on the calling thread's ring (never blocks)
+    static void Write(LogLevel level, std::ostringstream& message);
+    
+    // Blocks until everything queued so far has been written, after reporting
+    // messages that rate limits are still holding back. Call before printing
+    // directly to stdout when the order matters (end-of-run summaries).
+    static void Flush();
+    
+    // Per call site limiter: at most maxPerSecond messages in each one-second
+    // window; the next message that passes reports how many were suppressed,
+    // and Flush() reports any left over at the end of a run
+    class RateLimit {
+    public:
+        RateLimit(int maxPerSecond, LogLevel level, const char* file, int line);
+        bool allow(size_t& suppressedBefore);
+        void flushSuppressed();
+    
+    private:
+        const int maxPerSecond;
+        const LogLevel level;
+        const char* const file;
+        const int line;
+        std::atomic<int64_t> windowStart{0}; // ms, steady clock
+        std::atomic<int> windowCount{0};
+        std::atomic<size_t> suppressed{0};
+    };
+
+private:
+    static std::atomic<int> runtimeLevel;
+};
+
+#define SATSIM_LOG_ACTIVE(level) ((int)(level) >= SATSIM_LOG_COMPILE_LEVEL && Log::IsEnabled(level))
+
+#define SATSIM_LOG(level, expr) \
+    do { \
+        if(SATSIM_LOG_ACTIVE(level)) { \
+            std::ostringstream& logStream_ = Log::Stream(); \
+            logStream_ << expr; \
+            Log::Write(level, logStream_); \
+        } \
+    } while(0)
+
+#define SATSIM_LOG_RATE(level, maxPerSecond, expr) \
+    do { \
+        if(SATSIM_LOG_ACTIVE(level)) { \
+            static Log::RateLimit logLimit_(maxPerSecond, level, __FILE__, __LINE__); \
+            size_t logSuppressed_ = 0; \
+            if(logLimit_.allow(logSuppressed_)) { \
+                std::ostringstream& logStream_ = Log::Stream(); \
+                logStream_ << expr; \
+                if(logSuppressed_ > 0) logStream_ << " [" << logSuppressed_ << " similar suppressed]"; \
+                Log::Write(level, logStream_); \
+            } \
+        } \
+    } while(0)
+
+#define LOG_TRACE(expr) SATSIM_LOG(LogLevel::TRACE, expr)
+#define LOG_DEBUG(expr) SATSIM_LOG(LogLevel::DEBUG, expr)
+#define LOG_INFO(expr) SATSIM_LOG(LogLevel::INFO, expr)
+#define LOG_WARN(expr) SATSIM_LOG(LogLevel::WARN, expr)
+#define LOG_ERROR(expr) SATSIM_LOG(LogLevel::ERROR, expr)
+
+#define LOG_TRACE_RATE(perSecond, expr) SATSIM_LOG_RATE(LogLevel::TRACE, perSecond, expr)
+#define LOG_DEBUG_RATE(perSecond, expr) SATSIM_LOG_RATE(LogLevel::DEBUG, perSecond, expr)
+#define LOG_INFO_RATE(perSecond, expr) SATSIM_LOG_RATE(LogLevel::INFO, perSecond, expr)
+#define LOG_WARN_RATE(perSecond, expr) SATSIM_LOG_RATE(LogLevel::WARN, perSecond, expr)
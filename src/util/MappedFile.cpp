@@ -0,0 +1,48 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& filepath) {
+    close();
+    
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    length = (size_t)st.st_size;
+    if(length == 0) { // mmap rejects empty files; an empty range is still valid
+        ::close(fd);
+        data = "";
+        return true;
+    }
+    void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(map == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    madvise(map, length, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(map);
+    return true;
+}
+
+bool MappedFile::SectionFits(uint64_t offset, uint64_t count, size_t elementSize, size_t fileSize) {
+    if(offset > fileSize || (offset & 7) != 0) return false;
+    return count <= (fileSize - offset) / (elementSize ? elementSize : 1);
+}
+
+void MappedFile::close() {
+    if(data && length > 0) munmap(const_cast<char*>(data), length);
+    data = nullptr;
+    length = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool open(const std::string& filepath);
+    void close();
+    
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+    
+    // Section check for the mapped binary formats: count elements at offset
+    // lie inside a file of fileSize bytes and start 8-byte aligned. Written
+    // as a division so a crafted count cannot wrap the end offset around.
+    static bool SectionFits(uint64_t offset, uint64_t count, size_t elementSize, size_t fileSize);
+
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+};
@@ -0,0 +1,196 @@
+#include "RunRecording.h"
+#include "Log.h"
+#include <cstring>
+
+static_assert(sizeof(RecordingHeader) == 56, "RecordingHeader layout is part of the file format");
+
+namespace {
+const char RECORDING_MAGIC[8] = {'S', 'A', 'T', 'R', 'E', 'C', 0, 0};
+}
+
+RunRecorder::~RunRecorder() {
+    stop();
+}
+
+bool RunRecorder::start(const std::string& filepath, const RunScenario& scenario) {
+    stop();
+    
+    file.open(filepath, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()) {
+        LOG_ERROR("Failed to open recording: " << filepath);
+        return false;
+    }
+    path = filepath;
+    frameCount = 0;
+    last = RunControls();
+    
+    RecordingHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    h.version = RECORDING_VERSION;
+    h.headerSize = sizeof(RecordingHeader);
+    h.scenarioSeed = scenario.scenarioSeed;
+    h.debrisSeed = scenario.debrisSeed;
+    h.randomCount = scenario.randomCount;
+    h.flags = scenario.collisionTest ? RECORDING_COLLISION_TEST : 0;
+    h.analysisInterval = scenario.analysisInterval;
+    h.analysisWindow = scenario.analysisWindow;
+    h.initialConjunctionTimer = scenario.initialConjunctionTimer;
+    h.catalogPathLength = (uint32_t)scenario.catalogPath.size();
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.write(scenario.catalogPath.data(), scenario.catalogPath.size());
+    return file.good();
+}
+
+void RunRecorder::stop() {
+    if(!file.is_open()) return;
+    
+    // Frame count in the header, for progress and reports
+    file.seekp(offsetof(RecordingHeader, frameCount));
+    file.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+    file.close();
+    if(file.fail()) LOG_ERROR("Error writing recording: " << path);
+    else LOG_INFO("Recorded " << frameCount << " frames to " << path);
+}
+
+void RunRecorder::writeTag(RecordTag tag, const void* payload, size_t bytes) {
+    char entry[16];
+    entry[0] = (char)tag;
+    memcpy(entry + 1, payload, bytes);
+    file.write(entry, 1 + bytes);
+}
+
+void RunRecorder::frame(float deltaTime, const RunControls& c) {
+    if(!file.is_open()) return;
+    
+    // The first frame carries the full state, later frames only the changes
+    bool first = frameCount == 0;
+    if(first || c.timeScale != last.timeScale) writeTag(RecordTag::TIME_SCALE, &c.timeScale, sizeof(float));
+    if(first || c.paused != last.paused) {
+        uint8_t paused = c.paused ? 1 : 0;
+        writeTag(RecordTag::PAUSED, &paused, sizeof(paused));
+    }
+    if(first || c.selectedSatId != last.selectedSatId) {
+        int32_t id = c.selectedSatId;
+        writeTag(RecordTag::SELECTED_SAT, &id, sizeof(id));
+    }
+    if(first || c.viewFlags != last.viewFlags) writeTag(RecordTag::VIEW_FLAGS, &c.viewFlags, sizeof(uint32_t));
+    
+    // Same expression as the frame loops (float product added to the double
+    // sim time), so only jumps such as the STOP button need storing
+    SimTime predicted = last.simTime;
+    if(!c.paused) predicted += deltaTime * c.timeScale;
+    if(first || c.simTime != predicted) writeTag(RecordTag::SIM_TIME, &c.simTime, sizeof(SimTime));
+    
+    writeTag(RecordTag::FRAME, &deltaTime, sizeof(float));
+    last = c;
+    frameCount++;
+}
+
+RunReplay::~RunReplay() {
+    close();
+}
+
+bool RunReplay::open(const std::string& filepath) {
+    close();
+    
+    auto file = std::make_unique<MappedFile>();
+    if(!file->open(filepath)) {
+        LOG_ERROR("Failed to open recording: " << filepath);
+        return false;
+    }
+    
+    RecordingHeader h;
+    const char* error = nullptr;
+    if(file->size() < sizeof(RecordingHeader)) error = "file too small";
+    else {
+        memcpy(&h, file->begin(), sizeof(h));
+        if(memcmp(h.magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) error = "not a recording";
+        else if(h.version != RECORDING_VERSION || h.headerSize != sizeof(RecordingHeader))
+            error = "unsupported recording version";
+        else if(h.catalogPathLength > file->size() - sizeof(RecordingHeader)) error = "truncated file";
+    }
+    if(error) {
+        LOG_ERROR("Invalid recording " << filepath << ": " << error);
+        return false;
+    }
+    
+    scenario = RunScenario();
+    scenario.catalogPath.assign(file->begin() + sizeof(RecordingHeader), h.catalogPathLength);
+    scenario.collisionTest = (h.flags & RECORDING_COLLISION_TEST) != 0;
+    scenario.randomCount = h.randomCount;
+    scenario.scenarioSeed = h.scenarioSeed;
+    scenario.debrisSeed = h.debrisSeed;
+    scenario.analysisInterval = h.analysisInterval;
+    scenario.analysisWindow = h.analysisWindow;
+    scenario.initialConjunctionTimer = h.initialConjunctionTimer;
+    recordedFrames = h.frameCount;
+    
+    cursor = file->begin() + sizeof(RecordingHeader) + h.catalogPathLength;
+    end = file->end();
+    mapping = std::move(file);
+    return true;
+}
+
+void RunReplay::close() {
+    mapping.reset();
+    cursor = nullptr;
+    end = nullptr;
+}
+
+bool RunReplay::read(void* out, size_t bytes) {
+    if((size_t)(end - cursor) < bytes) return false;
+    memcpy(out, cursor, bytes);
+    cursor += bytes;
+    return true;
+}
+
+bool RunReplay::nextFrame(float& deltaTime, RunControls& controls) {
+    if(!mapping) return false;
+    
+    bool hasSimTime = false;
+    SimTime recordedSimTime = 0.0;
+    for(;;) {
+        uint8_t tag;
+        if(!read(&tag, sizeof(tag))) return false; // End of the recording
+        
+        bool ok = true;
+        switch((RecordTag)tag) {
+            case RecordTag::FRAME:
+                if(!read(&deltaTime, sizeof(float))) return false;
+                if(!controls.paused) controls.simTime += deltaTime * controls.timeScale;
+                if(hasSimTime) controls.simTime = recordedSimTime;
+                return true;
+            case RecordTag::SIM_TIME:
+                ok = read(&recordedSimTime, sizeof(SimTime));
+                hasSimTime = true;
+                break;
+            case RecordTag::TIME_SCALE:
+                ok = read(&controls.timeScale, sizeof(float));
+                break;
+            case RecordTag::PAUSED: {
+                uint8_t paused = 0;
+                ok = read(&paused, sizeof(paused));
+                controls.paused = paused != 0;
+                break;
+            }
+            case RecordTag::SELECTED_SAT: {
+                int32_t id = -1;
+                ok = read(&id, sizeof(id));
+                controls.selectedSatId = id;
+                break;
+            }
+            case RecordTag::VIEW_FLAGS:
+                ok = read(&controls.viewFlags, sizeof(uint32_t));
+                break;
+            default:
+                LOG_ERROR("Corrupt recording: unknown entry " << (int)tag << ", replay stopped");
+                cursor = end;
+                return false;
+        }
+        if(!ok) {
+            LOG_ERROR("Recording truncated mid-frame, replay stopped");
+            return false;
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "../sim/SimTime.h"
+#include "MappedFile.h"
+
+// Deterministic record/replay of a simulation run (.satrec). The recording
+// holds everything that is not a pure function of the scenario: the frame
+// deltas (wall clock in the windowed app), the UI-driven controls and the
+// RNG seeds. Replaying it reproduces the run exactly, frame by frame, as
+// fast as the machine allows, in the windowed app or the headless tool.
+//
+//   RecordingHeader
+//   char[catalogPathLength]
+//   entries: uint8_t RecordTag + payload, the changes of a frame before its FRAME
+//
+// A frame costs 5 bytes (tag + float delta) unless a control changed.
+
+const uint32_t RECORDING_VERSION = 1;
+
+struct RecordingHeader {
+    char magic[8];            // "SATREC\0\0"
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t scenarioSeed;    // ScenarioBuilder::AddRandomSatellites
+    uint32_t debrisSeed;      // srand() before the first frame (debris spread)
+    int32_t randomCount;
+    uint32_t flags;           // RECORDING_COLLISION_TEST
+    float analysisInterval;   // Sim seconds between conjunction analyses
+    float analysisWindow;     // Conjunction look-ahead (s)
+    float initialConjunctionTimer;
+    uint32_t catalogPathLength;
+    uint64_t frameCount;      // Patched when the recording is closed (0 if it was not)
+};
+
+const uint32_t RECORDING_COLLISION_TEST = 1u << 0;
+
+enum class RecordTag : uint8_t {
+    FRAME = 1,         // float deltaTime, ends the frame
+    SIM_TIME = 2,      // double: sim time after this frame's advance, when it is not last + delta * timeScale
+    TIME_SCALE = 3,    // float
+    PAUSED = 4,        // uint8_t
+    SELECTED_SAT = 5,  // int32_t
+    VIEW_FLAGS = 6     // uint32_t
+};
+
+// Scenario a run starts from
+struct RunScenario {
+    std::string catalogPath;
+    bool collisionTest = false;
+    int randomCount = 0;
+    uint32_t scenarioSeed = 42;
+    uint32_t debrisSeed = 43;
+    float analysisInterval = 60.0f;
+    float analysisWindow = 3600.0f;
+    float initialConjunctionTimer = 0.0f;
+};
+
+// Per-frame controls. simTime is the time the frame simulates (after the
+// advance); everything else is the state the frame ran with.
+struct RunControls {
+    SimTime simTime = 0.0;
+    float timeScale = 1.0f;
+    bool paused = false;
+    int selectedSatId = -1;
+    uint32_t viewFlags = 0;   // App display toggles (VIEW_*), part of the frame cost
+};
+
+const uint32_t VIEW_ORBITS = 1u << 0;
+const uint32_t VIEW_SATELLITES = 1u << 1;
+const uint32_t VIEW_DEBRIS = 1u << 2;
+const uint32_t VIEW_CAMERA_FOLLOW = 1u << 3;
+const uint32_t VIEW_CONJUNCTIONS = 1u << 4;
+
+class RunRecorder {
+public:
+    RunRecorder() = default;
+    ~RunRecorder(); // Closes the recording
+    
+    RunRecorder(const RunRecorder&) = delete;
+    RunRecorder& operator=(const RunRecorder&) = delete;
+    
+    bool start(const std::string& filepath, const RunScenario& scenario);
+    void stop();
+    bool isRecording() const { return file.is_open(); }
+    
+    // Once per frame, after the sim time advance. Writes only what the
+    // replay cannot predict from the previous frame.
+    void frame(float deltaTime, const RunControls& controls);
+    
+    uint64_t getFrameCount() const { return frameCount; }
+
+private:
+    std::ofstream file;
+    std::string path;
+    RunControls last;
+    uint64_t frameCount = 0;
+    
+    void writeTag(RecordTag tag, const void* payload, size_t bytes);
+};
+
+class RunReplay {
+public:
+    RunReplay() = default;
+    ~RunReplay();
+    
+    // Maps and validates the file; false (with a message) if it is not a compatible recording
+    bool open(const std::string& filepath);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+    
+    const RunScenario& getScenario() const { return scenario; }
+    uint64_t getRecordedFrames() const { return recordedFrames; }
+    
+    // Next frame: applies its control changes to controls and advances
+    // controls.simTime the way the recorded loop did (pass the current sim
+    // time in). False at the end of the recording.
+    bool nextFrame(float& deltaTime, RunControls& controls);
+
+private:
+    std::unique_ptr<MappedFile> mapping;
+    RunScenario scenario;
+    uint64_t recordedFrames = 0;
+    const char* cursor = nullptr;
+    const char* end = nullptr;
+    
+    bool read(void* out, size_t bytes);
+};
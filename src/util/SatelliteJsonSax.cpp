@@ -0,0 +1,179 @@
+#include "SatelliteJsonSax.h"
+#include <iostream>
+
+namespace {
+const char* const FIELD_NAMES[] = {
+    "id", "name", "semiMajorAxis", "eccentricity", "inclination", "raan", "argPeriapsis", "meanAnomaly"
+};
+
+// Every field except the name must be present
+const unsigned int REQUIRED_FIELDS = 0xFFu & ~(1u << 1);
+}
+
+SatelliteJsonSax::SatelliteJsonSax(std::vector<Satellite>& out, size_t firstRecord,
+                                   std::ostream& log, Layout layout)
+    : satellites(out)
+    , log(log)
+    , layout(layout)
+    , listDepth(layout == SINGLE_RECORD ? 0 : -1)
+    , recordBase(firstRecord)
+{
+}
+
+bool SatelliteJsonSax::number(double val) {
+    if(!atRecordField()) {
+        if(depth == listDepth) { // Bare value in the records array
+            beginRecord();
+            recordError = "record is not an object";
+            endRecord();
+        }
+        return true;
+    }
+    
+    switch(currentField) {
+        case FIELD_ID: current.id = (int)val; break;
+        case FIELD_SEMI_MAJOR_AXIS: current.semiMajorAxis = (float)val; break;
+        case FIELD_ECCENTRICITY: current.eccentricity = (float)val; break;
+        case FIELD_INCLINATION: current.inclination = glm::radians((float)val); break;
+        case FIELD_RAAN: current.raan = glm::radians((float)val); break;
+        case FIELD_ARG_PERIAPSIS: current.argPeriapsis = glm::radians((float)val); break;
+        case FIELD_MEAN_ANOMALY: current.meanAnomaly = glm::radians((float)val); break;
+        case FIELD_NAME: fieldTypeError("a string"); return true;
+        default: return true;
+    }
+    fieldsSeen |= 1u << currentField;
+    return true;
+}
+
+void SatelliteJsonSax::fieldTypeError(const char* expected) {
+    if(currentField == FIELD_UNKNOWN || !recordError.empty()) return;
+    recordError = std::string("'") + FIELD_NAMES[currentField] + "' must be " + expected;
+}
+
+bool SatelliteJsonSax::null() {
+    if(atRecordField()) fieldTypeError(currentField == FIELD_NAME ? "a string" : "a number");
+    else if(depth == listDepth) number(0.0);
+    return true;
+}
+
+bool SatelliteJsonSax::boolean(bool) {
+    return null();
+}
+
+bool SatelliteJsonSax::number_integer(number_integer_t val) {
+    return number((double)val);
+}
+
+bool SatelliteJsonSax::number_unsigned(number_unsigned_t val) {
+    return number((double)val);
+}
+
+bool SatelliteJsonSax::number_float(number_float_t val, const string_t&) {
+    return number(val);
+}
+
+bool SatelliteJsonSax::string(string_t& val) {
+    if(atRecordField()) {
+        if(currentField == FIELD_NAME) {
+            current.name = std::move(val);
+            fieldsSeen |= 1u << FIELD_NAME;
+        } else {
+            fieldTypeError("a number");
+        }
+    } else if(depth == listDepth) {
+        number(0.0);
+    }
+    return true;
+}
+
+bool SatelliteJsonSax::binary(binary_t&) {
+    return null();
+}
+
+bool SatelliteJsonSax::start_object(std::size_t) {
+    if(atRecordField()) fieldTypeError(currentField == FIELD_NAME ? "a string" : "a number");
+    depth++;
+    if(depth == listDepth + 1 && listDepth >= 0 && !inRecord) beginRecord();
+    return true;
+}
+
+bool SatelliteJsonSax::end_object() {
+    if(atRecordField()) endRecord();
+    depth--;
+    return true;
+}
+
+bool SatelliteJsonSax::start_array(std::size_t) {
+    if(atRecordField()) fieldTypeError(currentField == FIELD_NAME ? "a string" : "a number");
+    
+    // The records array is the root array, or the value of the root "satellites" key
+    if(listDepth < 0 && (depth == 0 || nextArrayIsList)) {
+        listDepth = depth + 1;
+    } else if(depth == listDepth) {
+        beginRecord();
+        recordError = "record is not an object";
+    }
+    nextArrayIsList = false;
+    depth++;
+    return true;
+}
+
+bool SatelliteJsonSax::end_array() {
+    depth--;
+    if(inRecord && depth == listDepth) endRecord(); // Array in place of a record object
+    return true;
+}
+
+bool SatelliteJsonSax::key(string_t& val) {
+    if(depth == 1 && listDepth < 0) {
+        nextArrayIsList = (val == "satellites");
+        return true;
+    }
+    if(atRecordField()) {
+        currentField = FIELD_UNKNOWN;
+        for(int f = 0; f < FIELD_COUNT; ++f) {
+            if(val == FIELD_NAMES[f]) {
+                currentField = (Field)f;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool SatelliteJsonSax::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+    parseError = ex.what();
+    return false; // Syntax errors end the stream; records loaded so far are kept
+}
+
+void SatelliteJsonSax::beginRecord() {
+    inRecord = true;
+    current = Satellite();
+    current.name = "Unknown";
+    current.color = glm::vec3(1.0f); // Default white
+    fieldsSeen = 0;
+    currentField = FIELD_UNKNOWN;
+    recordError.clear();
+}
+
+void SatelliteJsonSax::endRecord() {
+    inRecord = false;
+    size_t recordNumber = recordBase + recordCount++;
+    
+    if(recordError.empty() && (fieldsSeen & REQUIRED_FIELDS) != REQUIRED_FIELDS) {
+        for(int f = 0; f < FIELD_COUNT; ++f) {
+            if((REQUIRED_FIELDS & (1u << f)) && !(fieldsSeen & (1u << f))) {
+                recordError = std::string("missing '") + FIELD_NAMES[f] + "'";
+                break;
+            }
+        }
+    }
+    
+    if(!recordError.empty()) {
+        log << (layout == SINGLE_RECORD ? "Satellite record on line " : "Satellite record ")
+            << recordNumber << " skipped: " << recordError << std::endl;
+        skippedCount++;
+        return;
+    }
+    satellites.push_back(std::move(current));
+}
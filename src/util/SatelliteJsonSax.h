@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <ostream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include "../scene/Satellite.h"
+
+// SAX handler that fills Satellite records straight from the token stream,
+// so no JSON DOM is ever built. Accepts a bare array of records or the
+// { "satellites": [...] } wrapper. A bad record (missing or mistyped field)
+// is reported and skipped; the rest of the file still loads.
+class SatelliteJsonSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    using json = nlohmann::json;
+    
+    enum Layout {
+        RECORD_LIST,    // Array of records, bare or in the "satellites" wrapper
+        SINGLE_RECORD   // The document is one record object (a JSON-lines line)
+    };
+    
+    // firstRecord numbers the records in error messages; for SINGLE_RECORD it
+    // is the line number. Per-record errors go to log.
+    explicit SatelliteJsonSax(std::vector<Satellite>& out, size_t firstRecord = 0,
+                              std::ostream& log = std::cout, Layout layout = RECORD_LIST);
+    
+    size_t getRecordCount() const { return recordCount; }   // Records seen, loaded or not
+    size_t getSkippedCount() const { return skippedCount; }
+    bool foundList() const { return listDepth >= 0; }
+    const std::string& getParseError() const { return parseError; }
+    
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+    bool start_object(std::size_t elements) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool key(string_t& val) override;
+    bool parse_error(std::size_t position, const std::string& lastToken,
+                     const nlohmann::detail::exception& ex) override;
+
+private:
+    enum Field {
+        FIELD_ID = 0,
+        FIELD_NAME,
+        FIELD_SEMI_MAJOR_AXIS,
+        FIELD_ECCENTRICITY,
+        FIELD_INCLINATION,
+        FIELD_RAAN,
+        FIELD_ARG_PERIAPSIS,
+        FIELD_MEAN_ANOMALY,
+        FIELD_COUNT,
+        FIELD_UNKNOWN = FIELD_COUNT
+    };
+    
+    std::vector<Satellite>& satellites;
+    std::ostream& log;
+    Layout layout;
+    
+    int depth = 0;              // Current container nesting
+    int listDepth = -1;         // Depth inside the records array, -1 until found (0 for SINGLE_RECORD)
+    bool nextArrayIsList = false;
+    bool inRecord = false;
+    
+    Satellite current;
+    unsigned int fieldsSeen = 0;      // Bit per Field
+    Field currentField = FIELD_UNKNOWN;
+    std::string recordError;          // First error of the current record
+    
+    size_t recordBase;
+    size_t recordCount = 0;
+    size_t skippedCount = 0;
+    std::string parseError;
+    
+    bool atRecordField() const { return inRecord && depth == listDepth + 1; }
+    bool number(double val);          // Numeric value at the current position
+    void fieldTypeError(const char* expected);
+    void beginRecord();
+    void endRecord();
+};
@@ -0,0 +1,77 @@
+#include "ScenarioBuilder.h"
+#include "Log.h"
+#include <cstdlib>
+
+void ScenarioBuilder::AddCollisionTestPair(SatelliteCatalog& catalog) {
+    // ===== FORCED COLLISION TEST: Satellites start at SAME position! =====
+    // These satellites start at exactly the same point to trigger immediate collision warning
+    Satellite test1, test2;
+    
+    // Test satellite 1 - Very low LEO
+    test1.id = 9001;
+    test1.name = "COLLISION-SAT-A";
+    test1.semiMajorAxis = 6900.0f; // 529 km altitude - LOW orbit
+    test1.eccentricity = 0.0f;
+    test1.inclination = glm::radians(30.0f);
+    test1.raan = glm::radians(0.0f);
+    test1.argPeriapsis = glm::radians(0.0f);
+    test1.meanAnomaly = glm::radians(0.0f); // Starting at same position!
+    test1.color = glm::vec3(0.0f, 1.0f, 1.0f); // CYAN (Iridium-33 style)
+    
+    // Test satellite 2 - EXACT SAME POSITION (guaranteed collision at t=0!)
+    test2.id = 9002;
+    test2.name = "COLLISION-SAT-B";
+    test2.semiMajorAxis = 6900.0f; // Same altitude
+    test2.eccentricity = 0.0f;
+    test2.inclination = glm::radians(30.0f); // Same inclination
+    test2.raan = glm::radians(0.0f); // Same RAAN
+    test2.argPeriapsis = glm::radians(0.0f); // Same argument
+    test2.meanAnomaly = glm::radians(0.5f); // Almost same position (within 50km)
+    test2.color = glm::vec3(1.0f, 0.5f, 0.0f); // ORANGE (Cosmos-2251 style)
+    
+    catalog.addSatellite(test1);
+    catalog.addSatellite(test2);
+    
+    LOG_INFO("=== COLLISION TEST SATELLITES ADDED ===");
+    LOG_INFO("Sat 9001 (CYAN) and Sat 9002 (ORANGE) will collide!");
+    LOG_INFO("Watch for Conjunction Assessment Vectors!");
+}
+
+void ScenarioBuilder::AddRandomSatellites(SatelliteCatalog& catalog, int count, unsigned int seed) {
+    srand(seed);
+    for(int i = 0; i < count; ++i) {
+        Satellite s;
+        s.id = 1000 + i;
+        s.name = "SAT-" + std::to_string(s.id);
+        
+        // Distribution: Realistic altitudes to prevent clipping through Earth
+        // 70% LEO (400-2000km altitude = 6771-8371km radius)
+        // 20% MEO (2000-35000km altitude)
+        // 10% GEO (35786km altitude)
+        int type = rand() % 100;
+        if (type < 70) {
+            // LEO: 400-2000 km altitude
+            s.semiMajorAxis = 6771.0f + (rand() % 1600);
+        } else if (type < 90) {
+            // MEO: 2000-35000 km altitude
+            s.semiMajorAxis = 8371.0f + (rand() % 32629);
+        } else {
+            // GEO: ~35786 km altitude (42157 km radius)
+            s.semiMajorAxis = 42157.0f + (rand() % 200);
+        }
+
+        s.eccentricity = (rand() % 50) / 1000.0f; // Very low eccentricity
+        s.inclination = glm::radians((float)(rand() % 180));
+        s.raan = glm::radians((float)(rand() % 360));
+        s.argPeriapsis = glm::radians((float)(rand() % 360));
+        s.meanAnomaly = glm::radians((float)(rand() % 360));
+        
+        // Color for orbit lines
+        float alt = s.semiMajorAxis - 6371.0f;
+        if (alt < 2000) s.color = glm::vec3(0.4, 0.8, 1.0); // Cyan for LEO
+        else if (alt < 30000) s.color = glm::vec3(0.4, 1.0, 0.4); // Green for MEO
+        else s.color = glm::vec3(1.0, 0.4, 0.4); // Red for GEO
+        
+        catalog.addSatellite(s);
+    }
+}
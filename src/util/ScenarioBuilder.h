@@ -0,0 +1,12 @@
+#pragma once
+#include "../sim/SatelliteCatalog.h"
+
+// Built-in demo populations shared by the windowed app and the headless tool
+class ScenarioBuilder {
+public:
+    // Two satellites placed within the 50 km collision zone at t=0
+    static void AddCollisionTestPair(SatelliteCatalog& catalog);
+    
+    // Random LEO/MEO/GEO mix with ids starting at 1000 (deterministic for a given seed)
+    static void AddRandomSatellites(SatelliteCatalog& catalog, int count, unsigned int seed);
+};
@@ -0,0 +1,41 @@
+#include "StageTimer.h"
+#include <algorithm>
+#include <cstdio>
+
+StageTimer::StageTimer(std::vector<std::string> stageNames) {
+    for(auto& name : stageNames) {
+        Stage s;
+        s.name = std::move(name);
+        stages.push_back(s);
+    }
+}
+
+void StageTimer::lap(int stage) {
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - lapStart).count();
+    lapStart = now;
+    
+    Stage& s = stages[stage];
+    s.total += seconds;
+    s.max = std::max(s.max, seconds);
+}
+
+void StageTimer::report(std::ostream& out, double wallSeconds) const {
+    double timed = 0.0;
+    for(const auto& s : stages) timed += s.total;
+    
+    char line[160];
+    out << "\n=== STAGE TIMINGS (" << frameCount << " frames, " << wallSeconds << " s wall";
+    if(wallSeconds > 0.0) out << ", " << frameCount / wallSeconds << " frames/s";
+    out << ") ===\n";
+    snprintf(line, sizeof(line), "%-14s %10s %12s %10s %7s\n", "stage", "total ms", "ms/frame", "max ms", "share");
+    out << line;
+    for(const auto& s : stages) {
+        double perFrame = frameCount ? s.total * 1000.0 / frameCount : 0.0;
+        double share = timed > 0.0 ? 100.0 * s.total / timed : 0.0;
+        snprintf(line, sizeof(line), "%-14s %10.1f %12.4f %10.3f %6.1f%%\n",
+                 s.name.c_str(), s.total * 1000.0, perFrame, s.max * 1000.0, share);
+        out << line;
+    }
+    out.flush();
+}
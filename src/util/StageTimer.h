@@ -0,0 +1,36 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Wall-clock time spent in each stage of a frame loop, reported at the end
+// of a replay. Stages are indices into the name list given at construction;
+// the loop marks the end of each stage with a lap:
+//
+//   timer.startFrame();
+//   catalog.propagate(t);   timer.lap(STAGE_PROPAGATE);
+//   colMan.update(...);     timer.lap(STAGE_COLLISIONS);
+//   timer.endFrame();
+class StageTimer {
+public:
+    explicit StageTimer(std::vector<std::string> stageNames);
+    
+    void startFrame() { lapStart = std::chrono::steady_clock::now(); }
+    void lap(int stage); // Charges the time since the previous lap (or startFrame) to stage
+    void endFrame() { frameCount++; }
+    
+    // Per stage: total, mean per frame, longest lap and share of the timed total
+    void report(std::ostream& out, double wallSeconds) const;
+
+private:
+    struct Stage {
+        std::string name;
+        double total = 0.0;
+        double max = 0.0;
+    };
+    std::vector<Stage> stages;
+    size_t frameCount = 0;
+    std::chrono::steady_clock::time_point lapStart;
+};
@@ -0,0 +1,77 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    for(int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for(auto& t : workers) t.join();
+}
+
+int ThreadPool::DefaultThreadCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n > 0 ? (int)n : 1;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t, int)>& fn) {
+    if(count == 0) return;
+    
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    if(workers.empty() || count <= chunkSize) {
+        fn(0, count, 0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        jobChunk = chunkSize;
+        nextIndex.store(0);
+        busyWorkers = (int)workers.size();
+        generation++;
+    }
+    wakeCondition.notify_all();
+    
+    runChunks(0);
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned long seen = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+        }
+        
+        runChunks(worker);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::runChunks(int worker) {
+    while(true) {
+        size_t begin = nextIndex.fetch_add(jobChunk);
+        if(begin >= jobCount) break;
+        (*job)(begin, std::min(begin + jobChunk, jobCount), worker);
+    }
+}
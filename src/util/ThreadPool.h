@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of persistent worker threads for data-parallel loops. The calling
+// thread takes part in the work, so a pool of N threads spawns N-1 workers.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int getThreadCount() const { return (int)workers.size() + 1; }
+    
+    // Runs fn(begin, end, worker) over [0, count) and blocks until every chunk
+    // is done. Chunks are claimed dynamically from a shared cursor, so threads
+    // that finish early keep taking work from the remaining range. `worker`
+    // is in [0, getThreadCount()) and identifies per-thread scratch buffers.
+    void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t, int)>& fn);
+    
+    static int DefaultThreadCount();
+    
+private:
+    std::vector<std::thread> workers;
+    
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    
+    // Current job (valid while busyWorkers > 0 or the caller is running it)
+    const std::function<void(size_t, size_t, int)>* job = nullptr;
+    size_t jobCount = 0;
+    size_t jobChunk = 1;
+    std::atomic<size_t> nextIndex{0};
+    int busyWorkers = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+    
+    void workerLoop(int worker);
+    void runChunks(int worker);
+};
@@ -0,0 +1,273 @@
+#include "TleLoader.h"
+#include "CatalogIngest.h"
+#include "ThreadPool.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+const double DEG = 3.14159265358979323846 / 180.0;
+const double TWO_PI = 6.283185307179586;
+const double MU = 398600.4418; // Same constant as the two-body propagator
+const int TLE_LINE_LENGTH = 69;
+
+struct Line {
+    const char* text;
+    size_t length;
+    size_t number; // 1-based, for error messages
+};
+
+// Fixed-column numeric field, e.g. " 34.2682"
+double ParseField(const char* line, size_t start, size_t length) {
+    char buf[32];
+    length = std::min(length, sizeof(buf) - 1);
+    memcpy(buf, line + start, length);
+    buf[length] = '\0';
+    return strtod(buf, nullptr);
+}
+
+// Assumed-decimal field with exponent, e.g. " 28098-4" -> 0.28098e-4
+double ParseExpField(const char* line, size_t start) {
+    const char* p = line + start;
+    double sign = (p[0] == '-') ? -1.0 : 1.0;
+    double mantissa = ParseField(p, 1, 5) * 1.0e-5;
+    double exponent = ParseField(p, 6, 2);
+    return sign * mantissa * std::pow(10.0, exponent);
+}
+
+// Catalog number, including the Alpha-5 scheme (A0000 = 100000, I and O skipped)
+int ParseCatalogNumber(const char* line) {
+    char c = line[2];
+    if(c >= 'A' && c <= 'Z') {
+        int lead = c - 'A' + 10;
+        if(c > 'I') lead--;
+        if(c > 'O') lead--;
+        return lead * 10000 + (int)ParseField(line, 3, 4);
+    }
+    return (int)ParseField(line, 2, 5);
+}
+
+bool ChecksumValid(const char* line) {
+    int sum = 0;
+    for(int k = 0; k < TLE_LINE_LENGTH - 1; ++k) {
+        if(line[k] >= '0' && line[k] <= '9') sum += line[k] - '0';
+        else if(line[k] == '-') sum += 1;
+    }
+    return (sum % 10) == (line[TLE_LINE_LENGTH - 1] - '0');
+}
+
+bool IsElementLine(const Line& line, char kind) {
+    return line.length >= 2 && line.text[0] == kind && line.text[1] == ' ';
+}
+
+// Julian date of 0h UT on January 1 of the given year
+double JulianDateOfYear(int year) {
+    int y = year - 1;
+    return 1721425.5 + 365.0 * y + y / 4 - y / 100 + y / 400;
+}
+
+void ReportError(std::ostream& log, const Line& line, const char* reason) {
+    log << "TLE Parse Error (line " << line.number << "): " << reason << std::endl;
+}
+}
+
+size_t TleLoader::ParseBuffer(const char* begin, const char* end, std::vector<TleRecord>& out,
+                              size_t firstLine, std::ostream& log) {
+    // Split into lines once; trailing whitespace and CR are trimmed
+    std::vector<Line> lines;
+    size_t lineNumber = firstLine - 1;
+    for(const char* p = begin; p < end; ) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if(!eol) eol = end;
+        const char* last = eol;
+        while(last > p && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) last--;
+        lines.push_back({p, (size_t)(last - p), ++lineNumber});
+        p = eol + 1;
+    }
+    
+    size_t skipped = 0;
+    for(size_t k = 0; k < lines.size(); ++k) {
+        const Line& line1 = lines[k];
+        if(!IsElementLine(line1, '1')) continue;
+        
+        if(k + 1 >= lines.size() || !IsElementLine(lines[k + 1], '2')) {
+            ReportError(log, line1, "line 1 without a following line 2");
+            skipped++;
+            continue;
+        }
+        const Line& line2 = lines[++k];
+        
+        if(line1.length < (size_t)TLE_LINE_LENGTH || line2.length < (size_t)TLE_LINE_LENGTH) {
+            ReportError(log, line1, "element line shorter than 69 columns");
+            skipped++;
+            continue;
+        }
+        if(!ChecksumValid(line1.text) || !ChecksumValid(line2.text)) {
+            ReportError(log, line1, "checksum mismatch");
+            skipped++;
+            continue;
+        }
+        
+        TleRecord rec;
+        rec.catalogNumber = ParseCatalogNumber(line1.text);
+        if(ParseCatalogNumber(line2.text) != rec.catalogNumber) {
+            ReportError(log, line2, "catalog numbers of line 1 and line 2 differ");
+            skipped++;
+            continue;
+        }
+        
+        // 3LE: the title line directly precedes line 1 ("0 NAME" in Space-Track files)
+        if(k >= 2 && lines[k - 2].length > 0 && !IsElementLine(lines[k - 2], '1') && !IsElementLine(lines[k - 2], '2')) {
+            const Line& title = lines[k - 2];
+            size_t skip = (title.length > 2 && title.text[0] == '0' && title.text[1] == ' ') ? 2 : 0;
+            rec.name.assign(title.text + skip, title.length - skip);
+        }
+        
+        int year = (int)ParseField(line1.text, 18, 2);
+        year += (year < 57) ? 2000 : 1900;
+        double dayOfYear = ParseField(line1.text, 20, 12);
+        rec.epochJd = JulianDateOfYear(year) + dayOfYear - 1.0;
+        
+        TleElements& el = rec.elements;
+        el.epoch = 0.0;
+        el.bstar = ParseExpField(line1.text, 53);
+        el.inclination = ParseField(line2.text, 8, 8) * DEG;
+        el.raan = ParseField(line2.text, 17, 8) * DEG;
+        el.eccentricity = ParseField(line2.text, 26, 7) * 1.0e-7;
+        el.argPeriapsis = ParseField(line2.text, 34, 8) * DEG;
+        el.meanAnomaly = ParseField(line2.text, 43, 8) * DEG;
+        el.meanMotion = ParseField(line2.text, 52, 11) * TWO_PI / 1440.0; // rev/day -> rad/min
+        
+        out.push_back(rec);
+    }
+    return skipped;
+}
+
+std::vector<Satellite> TleLoader::BuildSatellites(const std::vector<TleRecord>& records, double scenarioEpochJd,
+                                                  std::ostream& log) {
+    std::vector<Satellite> satellites;
+    satellites.reserve(records.size());
+    
+    for(const auto& rec : records) {
+        TleElements el = rec.elements;
+        el.epoch = (rec.epochJd - scenarioEpochJd) * 86400.0;
+        
+        auto sgp4 = std::make_shared<Sgp4Record>();
+        Sgp4Propagator::Status status = Sgp4Propagator::Initialize(el, *sgp4);
+        if(status != Sgp4Propagator::OK) {
+            log << "SGP4 init failed for object " << rec.catalogNumber << " (error " << status << ")" << std::endl;
+            continue;
+        }
+        
+        Satellite s;
+        s.id = rec.catalogNumber;
+        s.name = rec.name.empty() ? "NORAD " + std::to_string(rec.catalogNumber) : rec.name;
+        
+        // Two-body approximation from the mean elements (band filter, orbit lines,
+        // fallback); the mean anomaly is moved from the element epoch to sim time 0
+        double a = Sgp4Propagator::SemiMajorAxisKm(*sgp4);
+        double M = el.meanAnomaly - std::sqrt(MU / (a * a * a)) * el.epoch;
+        s.semiMajorAxis = (float)a;
+        s.eccentricity = (float)el.eccentricity;
+        s.inclination = (float)el.inclination;
+        s.raan = (float)el.raan;
+        s.argPeriapsis = (float)el.argPeriapsis;
+        s.meanAnomaly = (float)(M - TWO_PI * std::floor(M / TWO_PI));
+        s.sgp4 = sgp4;
+        
+        float alt = s.semiMajorAxis - 6371.0f;
+        if (alt < 2000) s.color = glm::vec3(0.4, 0.8, 1.0); // Cyan for LEO
+        else if (alt < 30000) s.color = glm::vec3(0.4, 1.0, 0.4); // Green for MEO
+        else s.color = glm::vec3(1.0, 0.4, 0.4); // Red for GEO
+        
+        satellites.push_back(s);
+    }
+    return satellites;
+}
+
+const char* TleLoader::AlignToRecord(const char* candidate, const char* end) {
+    for(const char* p = candidate; p < end; ) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if(!eol) return end;
+        if(eol - p >= 2 && p[0] == '2' && p[1] == ' ') return eol + 1;
+        p = eol + 1;
+    }
+    return end;
+}
+
+std::vector<Satellite> TleLoader::LoadSatellites(const std::string& filepath, double* scenarioEpochJdOut) {
+    MappedFile file;
+    if(!file.open(filepath)) {
+        LOG_ERROR("Failed to open TLE file: " << filepath);
+        return {};
+    }
+    
+    std::vector<CatalogIngest::Chunk> chunks = CatalogIngest::Split(file.begin(), file.end(),
+                                                                    CatalogIngest::DefaultChunkCount(), AlignToRecord);
+    
+    // Per-chunk buffers; diagnostics are collected too and printed in file order
+    struct ChunkResult {
+        std::vector<TleRecord> records;
+        std::vector<Satellite> satellites;
+        std::ostringstream log;
+        size_t skipped = 0;
+    };
+    std::vector<ChunkResult> results(chunks.size());
+    ThreadPool pool(std::min<int>(ThreadPool::DefaultThreadCount(), (int)chunks.size()));
+    
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end, int) {
+        for(size_t c = begin; c < end; ++c) {
+            const CatalogIngest::Chunk& chunk = chunks[c];
+            ChunkResult& r = results[c];
+            r.records.reserve((chunk.end - chunk.begin) / (2 * TLE_LINE_LENGTH + 2));
+            r.skipped = ParseBuffer(chunk.begin, chunk.end, r.records, chunk.firstLine, r.log);
+        }
+    });
+    
+    size_t recordCount = 0;
+    size_t skipped = 0;
+    double scenarioEpochJd = 0.0;
+    for(const auto& r : results) {
+        for(const auto& rec : r.records) {
+            scenarioEpochJd = (recordCount++ == 0) ? rec.epochJd : std::max(scenarioEpochJd, rec.epochJd);
+        }
+        skipped += r.skipped;
+    }
+    if(recordCount == 0) {
+        Log::Flush();
+        for(const auto& r : results) std::cout << r.log.str();
+        LOG_ERROR("No element sets found in " << filepath);
+        return {};
+    }
+    
+    // SGP4 initialization is the larger share of the work; same chunks, second pass
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end, int) {
+        for(size_t c = begin; c < end; ++c) {
+            results[c].satellites = BuildSatellites(results[c].records, scenarioEpochJd, results[c].log);
+        }
+    });
+    
+    std::vector<Satellite> satellites;
+    size_t total = 0;
+    for(const auto& r : results) total += r.satellites.size();
+    satellites.reserve(total);
+    Log::Flush(); // Per-record diagnostics go straight to stdout, after anything queued
+    for(auto& r : results) {
+        std::cout << r.log.str();
+        std::move(r.satellites.begin(), r.satellites.end(), std::back_inserter(satellites));
+    }
+    size_t duplicates = CatalogIngest::RemoveDuplicateIds(satellites, filepath);
+    CatalogIngest::WarnDeepSpace(satellites);
+    
+    LOG_INFO("Loaded " << satellites.size() << " TLE objects from " << filepath
+             << " (" << skipped << " malformed records skipped, " << duplicates << " duplicates, "
+             << chunks.size() << " chunks, scenario epoch JD "
+             << std::fixed << scenarioEpochJd << std::defaultfloat << ")");
+    if(scenarioEpochJdOut) *scenarioEpochJdOut = scenarioEpochJd;
+    return satellites;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <ostream>
+#include <iostream>
+#include "../scene/Satellite.h"
+#include "../sim/Sgp4Propagator.h"
+
+// One parsed two-line element set (epoch still absolute)
+struct TleRecord {
+    int catalogNumber;
+    std::string name;       // From the 3LE title line, empty for plain TLE files
+    double epochJd;         // Julian date of the element epoch (UTC)
+    TleElements elements;   // elements.epoch is filled in once the scenario epoch is known
+};
+
+// Loader for NORAD two-line (TLE) and three-line (3LE) element files, as
+// published by CelesTrak and Space-Track. Objects are propagated with SGP4.
+class TleLoader {
+public:
+    // Sim time 0 is the newest element epoch in the file; older element sets
+    // get a negative epoch and are propagated forward from it. The file is
+    // mapped and parsed in parallel chunks; file order is preserved and a
+    // repeated catalog number keeps its first element set. The UTC Julian date
+    // of sim time 0 is stored in scenarioEpochJd, if given.
+    static std::vector<Satellite> LoadSatellites(const std::string& filepath, double* scenarioEpochJd = nullptr);
+    
+    // Parses every record in [begin, end) (whole lines), appending to out.
+    // Malformed records are reported to log, numbered from firstLine, and
+    // skipped. Returns the number skipped.
+    static size_t ParseBuffer(const char* begin, const char* end, std::vector<TleRecord>& out,
+                              size_t firstLine = 1, std::ostream& log = std::cout);
+    
+    // Initializes SGP4 for every record and converts it to a catalog entry
+    static std::vector<Satellite> BuildSatellites(const std::vector<TleRecord>& records, double scenarioEpochJd,
+                                                  std::ostream& log = std::cout);
+    
+    // Split point alignment for CatalogIngest: the line after the next line 2,
+    // which is where the following record (title or line 1) begins
+    static const char* AlignToRecord(const char* candidate, const char* end);
+};